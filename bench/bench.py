@@ -0,0 +1,277 @@
+#!/usr/bin/env python3
+"""
+runs the corpus in bench/corpus through every way this repo has of running brainf: each
+engine of bf at -O0 and -O1, and bf-to-c's output built with the system compiler. every
+run's output is checksummed against the others, so a fast wrong answer doesn't count.
+
+    python3 bench/bench.py                              # everything, 5 trials each
+    python3 bench/bench.py --only mandelbrot --configs jit-O1,bf-to-c
+    python3 bench/bench.py --json new.json --compare old.json
+
+--json writes every sample and its summary, --compare checks them against an earlier
+--json and exits with 2 if a pair got slower by more than --threshold and more than the
+noise of both. each run goes through measure.c, which also counts the instructions it
+retired where perf events are allowed, null otherwise.
+"""
+
+import argparse
+import hashlib
+import json
+import os
+import platform
+import random
+import shutil
+import statistics
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+ROOT = os.path.dirname(HERE)
+
+ENGINES = ['switch', 'threaded', 'jit', 'tiered', 'packed']
+NATIVE = {'jit', 'tiered'}  # engines that only build for x86-64
+
+# 97.5th percentile of Student's t by degrees of freedom, for 95% intervals
+T_975 = [12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+         2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086]
+
+
+def text_input(size, seed):
+    """printable lines from a fixed seed, the same bytes on every machine"""
+    rng = random.Random(seed)
+    words = [''.join(rng.choice('abcdefghijklmnopqrstuvwxyz') for _ in range(rng.randint(1, 9)))
+             for _ in range(4096)]
+    out, length = [], 0
+    while length < size:
+        line = ' '.join(rng.choice(words) for _ in range(12)) + '\n'
+        out.append(line)
+        length += len(line)
+    return ''.join(out).encode()[:size]
+
+
+# name, program, input, eof it needs and the md5 of what it prints
+CORPUS = [
+    {'name': 'hello', 'file': os.path.join(ROOT, 'hello.bf'), 'input': None, 'eof': None,
+     'md5': '8ddd8be4b179a529afa5f2ffae4b9858'},
+    {'name': 'mandelbrot', 'file': os.path.join(ROOT, 'mandelbrot.bf'), 'input': None, 'eof': None,
+     'md5': '5024283fa65866ddd347b877798e84d8'},
+    {'name': 'tape', 'file': os.path.join(HERE, 'corpus', 'tape.bf'), 'input': None, 'eof': None,
+     'md5': '2084b11dd5dac1c0440da8616c9f4268'},
+    {'name': 'nested', 'file': os.path.join(HERE, 'corpus', 'nested.bf'), 'input': None, 'eof': None,
+     'md5': 'bf072e9119077b4e76437a93986787ef'},
+    {'name': 'rot13', 'file': os.path.join(HERE, 'corpus', 'rot13.bf'), 'input': (1 << 18, 13), 'eof': None,
+     'md5': '761840c278dfdafa8fcc0a8150d333f6'},
+    {'name': 'cat', 'file': os.path.join(HERE, 'corpus', 'cat.bf'), 'input': (1 << 24, 1), 'eof': '0',
+     'md5': 'e8f67ea3d639228a42907227b4315b56'},
+]
+
+
+def run_cc(*args):
+    """runs the compiler, quietly unless it fails"""
+    result = subprocess.run(args, capture_output=True, text=True)
+    if result.returncode != 0:
+        sys.exit(result.stdout + result.stderr)
+
+
+def build(build_dir, cc):
+    """compiles bf, bf-to-c and measure, and each program of the corpus through bf-to-c"""
+    bf = os.path.join(build_dir, 'bf')
+    bf_to_c = os.path.join(build_dir, 'bf-to-c')
+
+    run_cc(cc, '-O2', '-pthread', '-o', bf, os.path.join(ROOT, 'bf-interpreter', 'bf.c'),
+            os.path.join(ROOT, 'bf-interpreter', 'libbf.c'))
+    run_cc(cc, '-O2', '-o', bf_to_c, os.path.join(ROOT, 'bf-to-lang', 'bf-to-c.c'))
+    run_cc(cc, '-O2', '-o', os.path.join(build_dir, 'measure'), os.path.join(HERE, 'measure.c'))
+
+    for bench in CORPUS:
+        # bf-to-c writes name.c next to name.bf, so work on a copy
+        source = os.path.join(build_dir, bench['name'] + '.bf')
+        shutil.copy(bench['file'], source)
+        subprocess.run([bf_to_c, source], check=True, stdout=subprocess.DEVNULL)
+        run_cc(cc, '-O2', '-o', os.path.join(build_dir, bench['name']), os.path.join(build_dir, bench['name'] + '.c'))
+
+        bench['input_path'] = None
+        if bench['input'] is not None:
+            bench['input_path'] = os.path.join(build_dir, bench['name'] + '.in')
+            with open(bench['input_path'], 'wb') as f:
+                f.write(text_input(*bench['input']))
+
+    return bf
+
+
+def configs(bf, build_dir, wanted):
+    """(name, function from a benchmark to its command and environment) for every way to run it"""
+    out = []
+    native = platform.machine() in ('x86_64', 'AMD64')
+
+    for engine in ENGINES:
+        if engine in NATIVE and not native:
+            continue
+        for level in ('-O0', '-O1'):
+            def command(bench, engine=engine, level=level):
+                args = [bf, '--engine=' + engine, level, '--no-cache']
+                if bench['eof'] is not None:
+                    args.append('--eof=' + bench['eof'])
+                return args + [bench['file']], None
+            out.append((engine + level, command))
+
+    def compiled(bench):
+        env = dict(os.environ)
+        if bench['eof'] is not None:
+            env['BF_EOF'] = bench['eof']
+        return [os.path.join(build_dir, bench['name'])], env
+    out.append(('bf-to-c', compiled))
+
+    return [c for c in out if wanted is None or c[0] in wanted]
+
+
+def run(build_dir, args, env, input_path):
+    """one run through measure: its costs, exit code and the md5 of its output"""
+    output_path = os.path.join(build_dir, 'output')
+    result_path = os.path.join(build_dir, 'result')
+
+    with open(input_path or os.devnull, 'rb') as stdin, open(output_path, 'wb') as stdout:
+        subprocess.run([os.path.join(build_dir, 'measure'), result_path] + args,
+                       stdin=stdin, stdout=stdout, env=env, check=True)
+
+    with open(result_path) as f:
+        result = json.load(f)
+
+    md5 = hashlib.md5()
+    with open(output_path, 'rb') as f:
+        for block in iter(lambda: f.read(1 << 20), b''):
+            md5.update(block)
+
+    result['md5'] = md5.hexdigest()
+    return result
+
+
+def summary(samples):
+    """mean, spread and a 95% interval on the mean"""
+    n = len(samples)
+    mean = statistics.fmean(samples)
+    stdev = statistics.stdev(samples) if n > 1 else 0.0
+    t = T_975[min(n - 2, len(T_975) - 1)] if n > 1 else 0.0
+
+    return {'n': n, 'mean': mean, 'median': statistics.median(samples), 'min': min(samples),
+            'max': max(samples), 'stdev': stdev, 'ci95': t * stdev / n ** 0.5, 'samples': samples}
+
+
+def compare(results, baseline_path, threshold, floor):
+    """pairs slower than the baseline by more than `threshold`, both intervals and `floor` seconds"""
+    with open(baseline_path) as f:
+        baseline = {(r['benchmark'], r['config']): r for r in json.load(f)['results']}
+
+    regressions = []
+    for r in results:
+        old = baseline.get((r['benchmark'], r['config']))
+        if old is None:
+            continue
+
+        new_wall, old_wall = r['wall'], old['wall']
+        change = new_wall['median'] / old_wall['median'] - 1
+        noise = new_wall['ci95'] + old_wall['ci95']
+
+        if change > threshold and new_wall['mean'] - old_wall['mean'] > max(noise, floor):
+            regressions.append((r['benchmark'], r['config'], change))
+
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description='benchmark every engine over the corpus')
+    parser.add_argument('--trials', type=int, default=5, help='timed runs of each pair (5)')
+    parser.add_argument('--warmup', type=int, default=1, help='untimed runs first (1)')
+    parser.add_argument('--only', help='benchmarks to run, comma separated')
+    parser.add_argument('--configs', help='configs to run, comma separated (jit-O1, bf-to-c, ...)')
+    parser.add_argument('--json', help='where to write the results')
+    parser.add_argument('--compare', help='results of an earlier --json to check against')
+    parser.add_argument('--threshold', type=float, default=0.05, help='slowdown --compare allows (0.05)')
+    parser.add_argument('--floor', type=float, default=1.0, help='ms a slowdown needs to count at all (1)')
+    parser.add_argument('--build-dir', help='keep the builds here instead of a temporary directory')
+    parser.add_argument('--cc', default=os.environ.get('CC', 'cc'), help='the compiler ($CC or cc)')
+    options = parser.parse_args()
+
+    only = set(options.only.split(',')) if options.only else None
+    wanted = set(options.configs.split(',')) if options.configs else None
+
+    temporary = None
+    build_dir = options.build_dir
+    if build_dir is None:
+        temporary = tempfile.TemporaryDirectory(prefix='bf-bench-')
+        build_dir = temporary.name
+    os.makedirs(build_dir, exist_ok=True)
+
+    bf = build(build_dir, options.cc)
+
+    results, wrong = [], 0
+    print('%-11s %-12s %10s %9s %9s %10s %14s' % ('benchmark', 'config', 'median ms', '+- ms', 'rstdev', 'rss KB', 'instructions'))
+
+    for bench in CORPUS:
+        if only is not None and bench['name'] not in only:
+            continue
+
+        for config, command in configs(bf, build_dir, wanted):
+            args, env = command(bench)
+
+            for _ in range(options.warmup):
+                run(build_dir, args, env, bench['input_path'])
+            runs = [run(build_dir, args, env, bench['input_path']) for _ in range(options.trials)]
+
+            ok = all(r['exit'] == 0 and r['md5'] == bench['md5'] for r in runs)
+            wrong += not ok
+
+            result = {
+                'benchmark': bench['name'],
+                'config': config,
+                'command': args,
+                'ok': ok,
+                'output_md5': sorted({r['md5'] for r in runs}),
+                'exit': sorted({r['exit'] for r in runs}),
+                'wall': summary([r['wall'] for r in runs]),
+                'user': summary([r['user'] for r in runs]),
+                'sys': summary([r['sys'] for r in runs]),
+                'max_rss_kb': max(r['max_rss_kb'] for r in runs),
+                'instructions': (summary([r['instructions'] for r in runs])
+                                 if all(r['instructions'] is not None for r in runs) else None),
+            }
+            results.append(result)
+
+            wall = result['wall']
+            print('%-11s %-12s %10.2f %9.2f %8.1f%% %10i %14s%s' % (
+                bench['name'], config, wall['median'] * 1e3, wall['ci95'] * 1e3,
+                100 * wall['stdev'] / wall['mean'] if wall['mean'] > 0 else 0, result['max_rss_kb'],
+                int(result['instructions']['median']) if result['instructions'] is not None else '-',
+                '' if ok else '  WRONG OUTPUT'), flush=True)
+
+    report = {
+        'commit': subprocess.run(['git', '-C', ROOT, 'rev-parse', 'HEAD'], capture_output=True, text=True).stdout.strip(),
+        'machine': {'system': platform.system(), 'machine': platform.machine(), 'processor': platform.processor(),
+                    'cpus': os.cpu_count(), 'python': platform.python_version()},
+        'cc': options.cc,
+        'trials': options.trials,
+        'warmup': options.warmup,
+        'results': results,
+    }
+
+    if options.json is not None:
+        with open(options.json, 'w') as f:
+            json.dump(report, f, indent=2)
+
+    status = 1 if wrong else 0
+
+    if options.compare is not None:
+        regressions = compare(results, options.compare, options.threshold, options.floor / 1e3)
+        for name, config, change in regressions:
+            print('regression: %s %s is %.1f%% slower' % (name, config, 100 * change))
+        if regressions:
+            status = 2
+
+    if temporary is not None:
+        temporary.cleanup()
+    sys.exit(status)
+
+
+if __name__ == '__main__':
+    main()
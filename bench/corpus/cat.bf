@@ -0,0 +1,4 @@
+  io heavy: copies the input to the output a byte at a time
+  needs a 0 at the end of the input (eof=0)
+
+,[.,]
@@ -0,0 +1,6 @@
+  deeply nested: 16 loops inside each other going round 3 times each so the
+  innermost runs 3 to the 16th times and adds 1 to the cell past them
+  prints that cell (3 to the 16th mod 256 = 65) and a newline
+
++++[>+++[>+++[>+++[>+++[>+++[>+++[>+++[>+++[>+++[>+++[>+++[>+++[>+++[>+++[>+++[>+<-]<-]<-]<-]<-]<-]<-]<-]<-]<-]<-]<-]<-]<-]<-]<-]
+>>>>>>>>>>>>>>>>.[-]++++++++++.
@@ -0,0 +1,259 @@
+  tape heavy: builds a row of about 64 thousand two cell records (a flag of 1 then a
+  data cell) out to roughly 128K cells so the tape has to grow while it runs
+  then sweeps the row 200 times adding 1 to every data cell and scanning back
+  prints the first data cell (200) and a newline
+
+>++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++>
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+-[[->>+<<]+>>-]
+<<[<<]>
+[->[>+>]<<[<<]>]
+>>.[-]++++++++++.
@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#endif
+
+/*
+ * runs a command and writes what it cost to RESULT as one line of JSON: wall time, user
+ * and system time, peak rss, instructions retired and the exit code. bench.py runs
+ * everything through this, a child of python would start out with python's rss.
+ */
+
+#define FAIL(code, ...) { fprintf(stderr, __VA_ARGS__); exit(code); }
+#define FAIL_IF(cond, code, ...) if (cond) { FAIL(code, __VA_ARGS__); }
+
+/* PROTOTYPES */
+
+int count_instructions(void);
+long long read_instructions(int counter);
+
+/* START */
+int main(int argc, char *argv[])
+{
+    FAIL_IF(argc < 3, 1, "Usage: '%s [result] [command...]'.\n", argv[0]);
+
+    FILE *result = fopen(argv[1], "w");
+    FAIL_IF(result == NULL, 2, "Error: unable to open [%s].\n", argv[1]);
+
+    // counts the child from its exec on, so the fork and this program aren't in the count
+    int counter = count_instructions();
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    pid_t pid = fork();
+    FAIL_IF(pid < 0, 2, "Error: unable to fork.\n");
+
+    if (pid == 0)
+    {
+        execvp(argv[2], argv + 2);
+        FAIL(127, "Error: unable to run [%s].\n", argv[2]);
+    }
+
+    int status;
+    struct rusage usage;
+    FAIL_IF(wait4(pid, &status, 0, &usage) != pid, 2, "Error: lost the child.\n");
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    long long instructions = read_instructions(counter);
+    int code = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+
+    fprintf(result, "{\"wall\": %.9f, \"user\": %.6f, \"sys\": %.6f, \"max_rss_kb\": %li, \"instructions\": ",
+            (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9,
+            usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6,
+            usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6,
+            usage.ru_maxrss);
+
+    if (instructions < 0) fprintf(result, "null");
+    else fprintf(result, "%lli", instructions);
+
+    fprintf(result, ", \"exit\": %i}\n", code);
+    fclose(result);
+
+    return 0;
+}
+
+/*
+ * opens a counter of user-space instructions that the next child inherits and starts
+ * at exec, -1 where perf events aren't there or aren't allowed (perf_event_paranoid).
+ */
+int count_instructions(void)
+{
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.enable_on_exec = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+// what the counter got to, the child's threads included, -1 without a counter
+long long read_instructions(int counter)
+{
+    if (counter < 0) return -1;
+
+    uint64_t count;
+    if (read(counter, &count, sizeof(count)) != sizeof(count)) return -1;
+
+    close(counter);
+    return count;
+}
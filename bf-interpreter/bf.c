@@ -1,47 +1,94 @@
 #include <stdio.h>
+#include <string.h>
 #include <sys/stat.h>
+#include <fcntl.h>
 #include <stdlib.h>
 #include <stdbool.h>
-#include <signal.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+
+#include "libbf.h"
+
+/*
+ * the command line: parses options into a context from libbf and feeds it a file or
+ * what is typed at the prompt. everything that compiles and runs lives in libbf.c.
+ */
 
+typedef unsigned char byte;
 
-/* BYTECODE */
-
-enum OPS {
-    OP_ADDN, // +
-    OP_SUBN, // -
-    OP_MOVL, // <
-    OP_MOVR, // >
-    OP_JMPL, // [
-    OP_JMPR, // ]
-    OP_SCAN, // ,
-    OP_PRNT, // .
-    OP_NULL  // non-keywords
-};
+// an option as it was given, so every context --batch and --serve make can be set up the same way
+typedef struct {
+    const char *name, *value;
+} OPTION;
 
+// shared by the --batch workers, each takes the next input nobody has yet
+typedef struct {
+    BF_PROGRAM *program;
+    char **inputs;
+    int count;
+    atomic_int next;
+    atomic_llong bytes_in, bytes_out;
+    atomic_int status;   // exit code, 0 unless some input failed
+    atomic_int unopened; // inputs that couldn't be opened, so never ran
+} BATCH;
+
+// a program --serve compiled, kept under its key until another one needs the slot
 typedef struct {
-    int OP_type;
-    int val;
-} INS;
+    uint64_t key;
+    char *source;        // a copy, a run only reuses the program if its source is the same
+    long long length;
+    BF_PROGRAM *program; // NULL for an empty slot
+    int users;           // connections running it, the slot is only reused at 0
+} SERVED;
+
+#define SERVE_SLOTS 1024
+#define SERVE_MAX (1ll << 26)   // most bytes of program or input one request can carry
+#define SERVE_CHUNK (1ll << 16) // a request's buffers start this big and double as it arrives
+#define SERVE_TIMEOUT 30        // seconds a client can leave a worker waiting on it
+#define JOBS_MAX 1024           // most --jobs, each worker's thread id sits on the stack
 
 /* PROTOTYPES */
 
 void run_file(char *filename);
 void run_prompt();
-void run_line(long long length);
-
-
-long long make_bytecode(long long length);
-long long make_ins(int prev_op, int cur_op, long long bytecode_length);
-
-bool      valid_file(char *filename);
-long long valid_line(char *line);
-
-long long get_file_length(char *filename);
+void run_batch(char *filename, char **inputs, int count);
+void *batch_worker(void *context);
+bool batch_open(const char *input, int *in, int *out);
+int batch_input(BF *worker, BATCH *work, const char *input, int in, int out);
+void run_fork(BATCH *work);
+void run_serve(const char *path);
+void *serve_worker(void *context);
+void serve_client(BF *worker, int client);
+char *serve_read(int client, long long length);
+BF_PROGRAM *serve_program(BF *worker, uint64_t key, const char *source, long long length, long long *error_point);
+void serve_release(BF_PROGRAM *program, uint64_t key);
+bool serve_write(void *context, const byte *data, size_t length);
+long long run_line(long long length);
+
+long long load_source(const char *filename);
 long long get_line_length(char *line);
-int get_op(char c);
-
-void show_error(const long long error_point, const char *line);
+void set_option(const char *name, const char *value);
+long long get_jobs(const char *text, const char *program);
+void init_cache(void);
+BF  *make_worker(void);
+bool read_all(int fd, void *data, size_t length);
+bool write_all(int fd, const void *data, size_t length);
+uint64_t hash_source(const char *source, long long length);
+void sip_round(uint64_t *v);
+
+void show_error(const long long error_point, const char *line, long long length);
+void show_usage(const char *program);
 
 // routine for freeing global heap-allocated variables
 void free_mem(void);
@@ -56,37 +103,84 @@ void free_mem(void);
 #define min(a, b) ((a < b) ? a : b)
 #endif
 
-typedef unsigned char byte;
-
 /* GLOBALS */
 
-#define ARR_SIZE 30000
-
+BF *bf = NULL;
 char *line = NULL;
-FILE *rptr = NULL;
-INS *bytecode = NULL;
-byte arr[ARR_SIZE] = {0}; // array for bf code
+long long line_mapped = 0; // bytes of `line` mapped from the source file, 0 when it is malloc'd
+const char *cache_dir = NULL;
+bool cache = true;
+bool dump = false;         // print the bytecode instead of running it
+bool profile = false;      // print the hottest loops after running
+const char *sample_path = NULL; // --sample: where the folded stacks go
+const char *sample_rate = "997";
+const char *sample_root = "bf"; // the script's name, the bottom frame of every stack
+bool batch = false;
+bool fork_children = false; // --fork: --batch runs each input in a process of its own
+long long jobs = 0;        // --batch and --serve worker threads, 0 for one per core
+const char *serve_path = NULL;
+
+SERVED served[SERVE_SLOTS];
+pthread_mutex_t served_lock = PTHREAD_MUTEX_INITIALIZER;
+uint64_t serve_secret[2]; // picked per server, so a client can't choose a source that takes another's key
+
+OPTION *options = NULL;
+int option_count = 0;
 
 /* START */
 int main(int argc, char *argv[])
 {
     atexit(free_mem);
 
-    switch (argc) 
+    char *filename = NULL;
+    char *inputs[argc];
+    int input_count = 0;
+
+    bf = bf_create();
+    options = malloc(sizeof(OPTION) * argc);
+    FAIL_IF(options == NULL, 2, "Error: unable to allocate memory.\n");
+
+    for (int i = 1; i < argc; i++)
     {
-        case 1:
-            run_prompt();
-            break;
-        case 2:
-            run_file(argv[1]);
-            break;
-        default:
-            FAIL(1, "Usage:\n"
-                    "%s        - run brainf code interactively.\n"
-                    "%s [file] - run brainf code from a script.\n\n", 
-                    argv[0], argv[0]);
-            break;
+        if (strncmp(argv[i], "--engine=", 9) == 0) set_option("engine", argv[i] + 9);
+        else if (strcmp(argv[i], "--jit") == 0) set_option("engine", "jit");
+        else if (strncmp(argv[i], "--tier-threshold=", 17) == 0) set_option("tier-threshold", argv[i] + 17);
+        else if (strncmp(argv[i], "--tape-size=", 12) == 0) set_option("tape-size", argv[i] + 12);
+        else if (strncmp(argv[i], "--max-steps=", 12) == 0) set_option("max-steps", argv[i] + 12);
+        else if (strncmp(argv[i], "--timeout=", 10) == 0) set_option("timeout", argv[i] + 10);
+        else if (strncmp(argv[i], "--flush=", 8) == 0) set_option("flush", argv[i] + 8);
+        else if (strncmp(argv[i], "--eof=", 6) == 0) set_option("eof", argv[i] + 6);
+        else if (strncmp(argv[i], "--passes=", 9) == 0) set_option("passes", argv[i] + 9);
+        else if (strcmp(argv[i], "-O0") == 0) set_option("passes", "");
+        else if (strcmp(argv[i], "-O1") == 0) set_option("passes", "all");
+        else if (strcmp(argv[i], "--dump") == 0) dump = true;
+        else if (strcmp(argv[i], "--profile") == 0) profile = true;
+        else if (strncmp(argv[i], "--sample=", 9) == 0) sample_path = argv[i] + 9;
+        else if (strncmp(argv[i], "--sample-rate=", 14) == 0) sample_rate = argv[i] + 14;
+        else if (strncmp(argv[i], "--cache-dir=", 12) == 0) cache_dir = argv[i] + 12;
+        else if (strcmp(argv[i], "--no-cache") == 0) cache = false;
+        else if (strcmp(argv[i], "--batch") == 0) batch = true;
+        else if (strcmp(argv[i], "--fork") == 0) fork_children = true;
+        else if (strncmp(argv[i], "--jobs=", 7) == 0) jobs = get_jobs(argv[i] + 7, argv[0]);
+        else if (strncmp(argv[i], "--serve=", 8) == 0) serve_path = argv[i] + 8;
+        else if (argv[i][0] == '-' && argv[i][1] != '\0') show_usage(argv[0]);
+        else if (filename == NULL) filename = argv[i];
+        else inputs[input_count++] = argv[i];
     }
+
+    if ((input_count > 0 && !batch) || (batch && filename == NULL) || (fork_children && !batch)) show_usage(argv[0]);
+    if (serve_path != NULL && (batch || filename != NULL)) show_usage(argv[0]);
+    if ((profile || sample_path != NULL) && (batch || serve_path != NULL)) show_usage(argv[0]);
+
+    if (profile) bf_option(bf, "profile", "on");
+    if (sample_path != NULL) set_option("sample-rate", sample_rate);
+    if (sample_path != NULL && atoll(sample_rate) == 0) show_usage(argv[0]); // a number, set_option checked
+    if (filename != NULL) sample_root = filename;
+
+    if (serve_path != NULL) run_serve(serve_path);
+    else if (batch) run_batch(filename, inputs, input_count);
+    else if (filename == NULL) run_prompt();
+    else run_file(filename);
 }
 
 void run_prompt()
@@ -94,6 +188,8 @@ void run_prompt()
     line = malloc(1001);
     FAIL_IF(line == NULL, 2, "Error: unable to allocate memory.\n");
 
+    bf_option(bf, "input", "stdio"); // scanf below shares stdin with ,
+
     for (int total_lines = 1, res; ; total_lines++)
     {
         printf("[%u] $ ", total_lines);
@@ -102,9 +198,9 @@ void run_prompt()
 
         getc(stdin); // remove newline
 
-        long long error_point = valid_line(line);
-        if (error_point != -1) show_error(error_point, line);
-        else run_line(get_line_length(line));
+        long long length = get_line_length(line);
+        long long error_point = run_line(length);
+        if (error_point != -1) show_error(error_point, line, length);
 
         // "clear" the string
         line[0] = '\0';
@@ -115,139 +211,605 @@ void run_prompt()
 
 void run_file(char *filename) 
 {
-    FAIL_IF(!valid_file(filename), 2, "Error: file does not exist [%s].\n", filename);
+    long long length = load_source(filename);
+    init_cache();
 
-    rptr = fopen(filename, "r");
-    FAIL_IF(rptr == NULL, 2, "Error: file pointer null.\n");
+    long long error_point = run_line(length);
+    if (error_point != -1) {
+        show_error(error_point, line, length);
+        FAIL(3, "Error: bad loop.\n");
+    }
 
-    long long length = get_file_length(filename);
+    free_mem();
+}
 
-    line = malloc(length + 1);
-    FAIL_IF(line == NULL, 2, "Error: unable to allocate memory.\n");
-    fread(line, sizeof(char), length, rptr);
-    line[length] = '\0';
+/*
+ * --batch: the script is compiled once and a pool of threads runs it over the inputs,
+ * each on a context of its own with the options from the command line. the output of
+ * an input goes next to it, with .out added to its name.
+ */
+void run_batch(char *filename, char **inputs, int count)
+{
+    long long length = load_source(filename);
+    init_cache();
 
-    long long error_point = valid_line(line);
-    if (error_point != -1) {
-        show_error(error_point, line);
+    long long error_point;
+    BATCH work = {.inputs = inputs, .count = count};
+
+    work.program = bf_compile(bf, line, length, &error_point);
+    if (work.program == NULL) {
+        show_error(error_point, line, length);
         FAIL(3, "Error: bad loop.\n");
     }
 
-    run_line(length);
+    if (jobs <= 0) jobs = sysconf(_SC_NPROCESSORS_ONLN);
+    jobs = max(1, min(jobs, count));
+
+    pthread_t threads[jobs];
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    if (fork_children) run_fork(&work);
+    else
+    {
+        for (int i = 0; i < jobs; i++)
+            FAIL_IF(pthread_create(&threads[i], NULL, batch_worker, &work) != 0, 2, "Error: unable to start a worker thread.\n");
+        for (int i = 0; i < jobs; i++) pthread_join(threads[i], NULL);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    seconds = max(seconds, 1e-9);
+
+    int ran = count - work.unopened;
+    printf("%i programs on %lli %s in %.3fs: %.1f programs/s, %.1f MB/s in, %.1f MB/s out\n",
+           ran, jobs, fork_children ? "processes" : "threads", seconds, ran / seconds,
+           work.bytes_in / seconds / 1e6, work.bytes_out / seconds / 1e6);
+    if (work.unopened > 0) printf("%i inputs could not be opened.\n", (int) work.unopened);
+
+    bf_free_program(work.program);
+    if (work.status != 0) exit(work.status);
 
     free_mem();
 }
 
-long long make_bytecode(long long length) 
+void *batch_worker(void *context)
 {
-    bytecode = malloc(sizeof(INS) * length);
-    FAIL_IF(bytecode == NULL, 2, "Error: unable to allocate memory.\n");
-    long long bytecode_length = 0;
+    BATCH *work = context;
+    BF *worker = make_worker();
 
-    for (int i = 0, j; i < length; i++) 
+    for (int i; (i = atomic_fetch_add(&work->next, 1)) < work->count; )
     {
-        int cur_op = get_op(line[i]);
+        int in, out, status = 2;
+
+        if (batch_open(work->inputs[i], &in, &out)) status = batch_input(worker, work, work->inputs[i], in, out);
+        else work->unopened++;
+
+        if (status != 0) work->status = status;
+    }
+
+    bf_destroy(worker);
+    return NULL;
+}
 
-        switch(cur_op)
+// opens `input` and <input>.out for batch_input, false with the error printed if either won't open
+bool batch_open(const char *input, int *in, int *out)
+{
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s.out", input);
+
+    *in = open(input, O_RDONLY);
+    *out = (*in < 0) ? -1 : open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (*in >= 0 && *out >= 0) return true;
+
+    printf("Error: unable to open [%s].\n", (*in < 0) ? input : path);
+    if (*in >= 0) close(*in);
+    return false;
+}
+
+// runs the script on one opened input into its .out, closes both and returns the exit code bf would have given
+int batch_input(BF *worker, BATCH *work, const char *input, int in, int out)
+{
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s.out", input);
+
+    int status = bf_run_fds(worker, work->program, in, out);
+
+    struct stat info;
+    if (fstat(in, &info) == 0) work->bytes_in += info.st_size;
+    work->bytes_out += max(0, lseek(out, 0, SEEK_CUR));
+
+    close(in);
+    if (close(out) != 0) status = -1;
+
+    if (status == BF_TAPE_ERROR) {
+        printf("Error: pointer moved off the tape [%s].\n", input);
+        return 4;
+    }
+    else if (status == BF_STEP_LIMIT || status == BF_TIME_LIMIT) {
+        printf("Error: %s limit reached at instruction %lli after %lli steps [%s].\n",
+               (status == BF_STEP_LIMIT) ? "step" : "time", bf_stopped_at(worker), bf_steps(worker), input);
+        return (status == BF_STEP_LIMIT) ? 5 : 6;
+    }
+    else if (status != BF_OK) {
+        printf("Error: unable to write [%s].\n", path);
+        return 2;
+    }
+
+    return 0;
+}
+
+/*
+ * --fork: the parent compiles the script and makes the engine's code, then forks a child
+ * per input, up to --jobs at once. children share the program, the code and the untouched
+ * tape copy-on-write, so each costs a fork instead of an exec, a parse and a compile, and
+ * one that crashes takes only itself down. what each child used is printed as it exits.
+ */
+void run_fork(BATCH *work)
+{
+    bf_prepare(bf, work->program);
+
+    pid_t pids[jobs];
+    int owners[jobs]; // the input each child slot is running
+    memset(pids, 0, sizeof(pids));
+
+    long long user = 0, system = 0, minor = 0, major = 0, rss = 0; // over all children, us and KB
+
+    for (int running = 0; running > 0 || work->next < work->count; )
+    {
+        if (running < jobs && work->next < work->count)
         {
-            case OP_JMPL:
-                bytecode[bytecode_length] = (INS) {OP_JMPL, -1};
-                bytecode_length++;
-                break;
-            case OP_JMPR:
-                j = bytecode_length - 1;
-                while(bytecode[j].OP_type != OP_JMPL || bytecode[j].val != -1) j--;
-                bytecode[j].val = bytecode_length;
-
-                bytecode[bytecode_length] = (INS) {OP_JMPR, j};
-                bytecode_length++;
-            case OP_NULL: break;
-            default:
-                if (bytecode_length > 0 && bytecode[bytecode_length - 1].OP_type == cur_op) bytecode[bytecode_length - 1].val++;
-                else 
-                {
-                    bytecode[bytecode_length] = (INS) {cur_op, 1};
-                    bytecode_length++;
-                }
-                break;
+            // an input that won't open isn't worth a child
+            int next = work->next++, in, out;
+            if (!batch_open(work->inputs[next], &in, &out))
+            {
+                work->unopened++;
+                work->status = 2;
+                continue;
+            }
+
+            int slot = 0;
+            while (pids[slot] != 0) slot++;
+
+            owners[slot] = next;
+            fflush(stdout); // or the child prints what the parent had buffered again
+
+            pids[slot] = fork();
+            FAIL_IF(pids[slot] < 0, 2, "Error: unable to start a child process.\n");
+
+            if (pids[slot] == 0)
+            {
+                int code = batch_input(bf, work, work->inputs[next], in, out);
+                fflush(stdout);
+                _exit(code);
+            }
+
+            close(in);
+            close(out);
+            running++;
+            continue;
         }
+
+        int status;
+        struct rusage usage;
+        pid_t pid = wait4(-1, &status, 0, &usage);
+        if (pid < 0) continue;
+
+        int slot = 0;
+        while (pids[slot] != pid) slot++;
+        pids[slot] = 0;
+        running--;
+
+        const char *input = work->inputs[owners[slot]];
+        int code = WIFEXITED(status) ? WEXITSTATUS(status) : 2;
+
+        if (WIFSIGNALED(status)) printf("Error: killed by signal %i [%s].\n", WTERMSIG(status), input);
+        if (code != 0) work->status = code;
+
+        // the child's counts stay in the child, the files say what it read and wrote
+        char path[PATH_MAX];
+        struct stat info;
+        snprintf(path, sizeof(path), "%s.out", input);
+        if (stat(input, &info) == 0) work->bytes_in += info.st_size;
+        if (stat(path, &info) == 0) work->bytes_out += info.st_size;
+
+        long long child_user = usage.ru_utime.tv_sec * 1000000ll + usage.ru_utime.tv_usec;
+        long long child_system = usage.ru_stime.tv_sec * 1000000ll + usage.ru_stime.tv_usec;
+
+        printf("[%s] exit %i: %.3fms user, %.3fms sys, %li KB max rss, %li minor and %li major faults\n",
+               input, code, child_user / 1e3, child_system / 1e3, usage.ru_maxrss, usage.ru_minflt, usage.ru_majflt);
+
+        user += child_user;
+        system += child_system;
+        minor += usage.ru_minflt;
+        major += usage.ru_majflt;
+        rss = max(rss, usage.ru_maxrss);
     }
 
-    return bytecode_length;
+    int count = max(1, work->count - work->unopened);
+    printf("children: %.3fms user, %.3fms sys, %.1f minor and %.1f major faults on average, %lli KB max rss\n",
+           user / 1e3 / count, system / 1e3 / count, (double) minor / count, (double) major / count, rss);
+}
+
+/*
+ * --serve=PATH: listens on a unix socket and answers one request per connection,
+ *
+ *   run <program length> <input length>\n<program><input>
+ *   hash <key> <input length>\n<input>     runs a program an earlier run sent
+ *
+ * with "ok <key>\n", the output in chunks of "<length>\n<bytes>" as the program flushes
+ * it, then "end ok\n", "end tape\n" if it moved off the tape or "end steps <instruction>\n"
+ * and "end time <instruction>\n" if a budget stopped it. a request that can't be run
+ * gets "error <reason>\n", and a client that stalls for SERVE_TIMEOUT seconds is dropped.
+ * compiled programs are kept by key, so a repeated program skips compiling, until
+ * another one lands in its slot. keys are only good for the server that handed them out.
+ */
+void run_serve(const char *path)
+{
+    struct sockaddr_un address = {.sun_family = AF_UNIX};
+    FAIL_IF(strlen(path) >= sizeof(address.sun_path), 1, "Error: socket path too long [%s].\n", path);
+    strcpy(address.sun_path, path);
+
+    // a socket left behind by an earlier server is in the way, anything else is not ours
+    struct stat info;
+    if (lstat(path, &info) == 0 && S_ISSOCK(info.st_mode)) unlink(path);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    FAIL_IF(listener < 0 || bind(listener, (struct sockaddr *) &address, sizeof(address)) != 0 || listen(listener, 128) != 0,
+            2, "Error: unable to listen on [%s].\n", path);
+
+    init_cache();
+
+    int random = open("/dev/urandom", O_RDONLY);
+    FAIL_IF(random < 0 || !read_all(random, serve_secret, sizeof(serve_secret)), 2, "Error: unable to read /dev/urandom.\n");
+    close(random);
+
+    if (jobs <= 0) jobs = sysconf(_SC_NPROCESSORS_ONLN);
+    jobs = max(jobs, 1);
+
+    printf("Serving on %s with %lli workers.\n", path, jobs);
+    fflush(stdout);
+
+    pthread_t threads[jobs];
+    for (int i = 0; i < jobs; i++)
+        FAIL_IF(pthread_create(&threads[i], NULL, serve_worker, &listener) != 0, 2, "Error: unable to start a worker thread.\n");
+    for (int i = 0; i < jobs; i++) pthread_join(threads[i], NULL);
 }
 
+// every worker waits in accept, the kernel hands each connection to one of them
+void *serve_worker(void *context)
+{
+    int listener = *(int *) context;
+    BF *worker = make_worker();
 
-void run_line(long long length)
+    for (;;)
+    {
+        int client = accept(listener, NULL, NULL);
+        if (client < 0) continue;
+
+        // a client that stops sending, or stops reading its output, gives the worker back
+        struct timeval timeout = {SERVE_TIMEOUT, 0};
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+        serve_client(worker, client);
+        close(client);
+    }
+
+    return NULL;
+}
+
+void serve_client(BF *worker, int client)
 {
-    long long bytecode_length = make_bytecode(length);
-    static int index = 0;
+    char header[128], reply[64];
+    size_t used = 0;
+
+    // a byte at a time, so nothing past the header is taken from the socket
+    while (used < sizeof(header) - 1 && read_all(client, header + used, 1) && header[used] != '\n') used++;
+    header[used] = '\0';
+
+    unsigned long long key = 0;
+    long long length = -1, input_length = -1;
+    bool run = sscanf(header, "run %lld %lld", &length, &input_length) == 2;
+
+    if ((!run && sscanf(header, "hash %llx %lld", &key, &input_length) != 2) || (run && length < 0))
+    {
+        write_all(client, "error bad request\n", 18);
+        return;
+    }
+
+    if (length > SERVE_MAX || input_length < 0 || input_length > SERVE_MAX)
+    {
+        write_all(client, "error too large\n", 16);
+        return;
+    }
+
+    errno = 0;
+    char *source = run ? serve_read(client, length) : NULL;
+    byte *input = (!run || source != NULL) ? (byte *) serve_read(client, input_length) : NULL;
+
+    // the client hung up or went quiet, unless there wasn't the memory for what it sent
+    if ((run && source == NULL) || input == NULL)
+    {
+        if (errno == ENOMEM) write_all(client, "error out of memory\n", 20);
+        free(source);
+        free(input);
+        return;
+    }
+
+    long long error_point = -1;
+    if (run) key = hash_source(source, length);
+    BF_PROGRAM *program = serve_program(worker, key, source, length, &error_point);
+
+    if (program == NULL && run) snprintf(reply, sizeof(reply), "error bad loop at %lli\n", error_point);
+    else if (program == NULL) snprintf(reply, sizeof(reply), "error unknown program\n");
+    else snprintf(reply, sizeof(reply), "ok %016llx\n", key);
+
+    write_all(client, reply, strlen(reply));
+    free(source);
 
-    // for (int i = 0; i < bytecode_length; i++) printf("%i ", bytecode[i].OP_type); printf("\n");
-    // for (int i = 0; i < bytecode_length; i++) printf("%i ", bytecode[i].val); printf("\n");
+    if (program != NULL)
+    {
+        int status = bf_run_stream(worker, program, input, input_length, serve_write, &client);
+        serve_release(program, key);
+
+        if (status == BF_STEP_LIMIT || status == BF_TIME_LIMIT)
+            snprintf(reply, sizeof(reply), "end %s %lli\n", (status == BF_STEP_LIMIT) ? "steps" : "time", bf_stopped_at(worker));
+        else snprintf(reply, sizeof(reply), (status == BF_TAPE_ERROR) ? "end tape\n" : "end ok\n");
+
+        if (status != BF_OUTPUT_CLOSED) write_all(client, reply, strlen(reply));
+    }
 
-    for (long long i = 0; i < bytecode_length; i++)
+    free(input);
+}
+
+/*
+ * the `length` bytes a client said it would send, in a buffer one byte longer. the buffer
+ * grows as they arrive, so a header alone can't make the server allocate much. NULL if the
+ * client stopped short, errno being ENOMEM if it was memory that ran out instead.
+ */
+char *serve_read(int client, long long length)
+{
+    long long capacity = min(length, SERVE_CHUNK), done = 0;
+    char *data = malloc(capacity + 1);
+
+    while (data != NULL && done < length)
     {
-        // printf("code=%i val=%i i=%lli\n", bytecode[i].OP_type, bytecode[i].val, i);
-        switch(bytecode[i].OP_type)
+        if (done == capacity)
+        {
+            capacity = min(2 * capacity, length);
+            char *grown = realloc(data, capacity + 1);
+            if (grown == NULL) free(data);
+            data = grown;
+            continue;
+        }
+
+        if (read_all(client, data + done, capacity - done)) done = capacity;
+        else
         {
-            case OP_ADDN:
-                arr[index] += bytecode[i].val;
-                break;
-            case OP_SUBN:
-                arr[index] -= bytecode[i].val;
-                break;
-            case OP_MOVL:
-                index -= bytecode[i].val;
-                break;
-            case OP_MOVR:
-                index += bytecode[i].val;
-                break;
-            case OP_JMPL:
-                if (arr[index] == 0) i = bytecode[i].val;
-                break;
-            case OP_JMPR:
-                i = bytecode[i].val - 1; // subtract 1 because of i++
-                break;
-            case OP_SCAN:
-                for (int j = 0; j < bytecode[i].val; j++) arr[index] = getchar();
-                break;
-            case OP_PRNT:
-                for (int j = 0; j < bytecode[i].val; j++) putchar(arr[index]);
-                break;
-                // case OP_NULL: break;
+            free(data);
+            data = NULL;
         }
-        // for (int j = 0; j < 10; j++) printf("%i ", arr[j]); printf("\nindex=%i\n", index);
     }
-    
-    // printf("free %p\n", bytecode);
-    free(bytecode);
-    bytecode = NULL;
+
+    return data;
+}
+
+/*
+ * the program for `key`, compiling `source` on a miss unless it is NULL. the caller
+ * holds on to it until serve_release.
+ */
+BF_PROGRAM *serve_program(BF *worker, uint64_t key, const char *source, long long length, long long *error_point)
+{
+    SERVED *slot = &served[key % SERVE_SLOTS];
+
+    pthread_mutex_lock(&served_lock);
+    bool same = slot->program != NULL && slot->key == key
+                && (source == NULL || (slot->length == length && memcmp(slot->source, source, length) == 0));
+    BF_PROGRAM *program = same ? slot->program : NULL;
+    if (program != NULL) slot->users++;
+    pthread_mutex_unlock(&served_lock);
+
+    if (program != NULL || source == NULL) return program;
+
+    // compiled outside the lock so a big program doesn't hold up the other workers
+    program = bf_compile(worker, source, length, error_point);
+    if (program == NULL) return NULL;
+
+    char *copy = malloc(max(length, 1));
+    FAIL_IF(copy == NULL, 2, "Error: unable to allocate memory.\n");
+    memcpy(copy, source, length);
+
+    pthread_mutex_lock(&served_lock);
+    if (slot->users == 0)
+    {
+        bf_free_program(slot->program);
+        free(slot->source);
+        *slot = (SERVED) {key, copy, length, program, 1};
+        copy = NULL;
+    }
+    pthread_mutex_unlock(&served_lock);
+
+    free(copy);
+
+    return program;
 }
 
-bool valid_file(char *filename) 
+// a program that didn't get a slot, because another was running in it, goes once it is done
+void serve_release(BF_PROGRAM *program, uint64_t key)
 {
-    struct stat buffer;   
-    return (stat(filename, &buffer) == 0);
+    SERVED *slot = &served[key % SERVE_SLOTS];
+
+    pthread_mutex_lock(&served_lock);
+    bool kept = slot->program == program;
+    if (kept) slot->users--;
+    pthread_mutex_unlock(&served_lock);
+
+    if (!kept) bf_free_program(program);
 }
 
-// goes through the string and returns index of the first invalid bracket, returns -1 if it is OK
-long long valid_line(char *line)
+// frames a piece of output for the client, see run_serve
+bool serve_write(void *context, const byte *data, size_t length)
 {
-    long long index, count, error_point = -1;
+    int client = *(int *) context;
+    char header[32];
 
-    for (index = 0, count = 0; line[index] != '\0'; index++)
+    int used = snprintf(header, sizeof(header), "%zu\n", length);
+    return write_all(client, header, used) && write_all(client, data, length);
+}
+
+bool read_all(int fd, void *data, size_t length)
+{
+    for (size_t done = 0; done < length; )
     {
-        if (line[index] == '[') 
+        ssize_t got = read(fd, (char *) data + done, length - done);
+
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        done += got;
+    }
+
+    return true;
+}
+
+// MSG_NOSIGNAL, so a client that hung up is a failed write instead of a SIGPIPE
+bool write_all(int fd, const void *data, size_t length)
+{
+    for (size_t done = 0; done < length; )
+    {
+        ssize_t sent = send(fd, (const char *) data + done, length - done, MSG_NOSIGNAL);
+
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent < 0) return false;
+        done += sent;
+    }
+
+    return true;
+}
+
+// SipHash-2-4 under serve_secret, the key a served program is kept under
+uint64_t hash_source(const char *source, long long length)
+{
+    uint64_t v[4] = {serve_secret[0] ^ 0x736f6d6570736575ull, serve_secret[1] ^ 0x646f72616e646f6dull,
+                     serve_secret[0] ^ 0x6c7967656e657261ull, serve_secret[1] ^ 0x7465646279746573ull};
+
+    // 8 bytes at a time, little endian, the last word is what's left with the length in its top byte
+    for (long long i = 0; i <= length; i += 8)
+    {
+        uint64_t word = (i + 8 > length) ? (uint64_t) length << 56 : 0;
+        for (long long j = 0; j < 8 && i + j < length; j++) word |= (uint64_t) (byte) source[i + j] << (8 * j);
+
+        v[3] ^= word;
+        sip_round(v);
+        sip_round(v);
+        v[0] ^= word;
+    }
+
+    v[2] ^= 0xff;
+    for (int i = 0; i < 4; i++) sip_round(v);
+
+    return v[0] ^ v[1] ^ v[2] ^ v[3];
+}
+
+#define ROTATE(x, n) (((x) << (n)) | ((x) >> (64 - (n))))
+
+void sip_round(uint64_t *v)
+{
+    v[0] += v[1], v[1] = ROTATE(v[1], 13) ^ v[0], v[0] = ROTATE(v[0], 32);
+    v[2] += v[3], v[3] = ROTATE(v[3], 16) ^ v[2];
+    v[0] += v[3], v[3] = ROTATE(v[3], 21) ^ v[0];
+    v[2] += v[1], v[1] = ROTATE(v[1], 17) ^ v[2], v[2] = ROTATE(v[2], 32);
+}
+
+// compiles and runs `line`, returns the index of the first invalid bracket or -1 if it is OK
+long long run_line(long long length)
+{
+    long long error_point;
+    BF_PROGRAM *program = bf_compile(bf, line, length, &error_point);
+    if (program == NULL) return error_point;
+
+    int status = dump ? BF_OK : bf_run(bf, program);
+    if (dump) bf_dump(program, stdout);
+    else if (profile) bf_profile(bf, program, line, stderr, 10);
+
+    if (!dump && sample_path != NULL)
+    {
+        FILE *samples = fopen(sample_path, "w");
+        FAIL_IF(samples == NULL, 2, "Error: unable to open [%s].\n", sample_path);
+        long long count = bf_samples(bf, program, line, sample_root, samples);
+        fclose(samples);
+        fprintf(stderr, "%lli samples written to %s.\n", count, sample_path);
+    }
+
+    // where a stopped run was, " at instruction 12 (3:40)"
+    char at[96] = "";
+    long long stopped = bf_stopped_at(bf), stopped_line, stopped_column;
+    if (bf_place(program, stopped, &stopped_line, &stopped_column))
+        snprintf(at, sizeof(at), " at instruction %lli (%lli:%lli)", stopped, stopped_line, stopped_column);
+
+    bf_free_program(program);
+    FAIL_IF(status == BF_TAPE_ERROR, 4, "Error: pointer moved off the tape%s.\n", at);
+    FAIL_IF(status == BF_STEP_LIMIT, 5, "Error: step limit reached%s after %lli steps.\n", at, bf_steps(bf));
+    FAIL_IF(status == BF_TIME_LIMIT, 6, "Error: time limit reached%s after %lli steps.\n", at, bf_steps(bf));
+
+    return -1;
+}
+
+/*
+ * points `line` at the source in `filename`, "-" being stdin, and returns its length.
+ * a regular file is mapped read-only and lexed where it is, anything else (pipes,
+ * terminals) is read in blocks. `line` isn't 0 terminated either way.
+ */
+long long load_source(const char *filename)
+{
+    int fd = (strcmp(filename, "-") == 0) ? STDIN_FILENO : open(filename, O_RDONLY);
+    FAIL_IF(fd < 0, 2, "Error: file does not exist [%s].\n", filename);
+
+    struct stat info;
+    FAIL_IF(fstat(fd, &info) != 0, 2, "Error: unable to read [%s].\n", filename);
+
+    if (S_ISREG(info.st_mode) && info.st_size > 0)
+    {
+        void *data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (data != MAP_FAILED)
+        {
+            madvise(data, info.st_size, MADV_SEQUENTIAL);
+            line = data;
+            line_mapped = info.st_size;
+
+            // a program read from stdin starts its input after itself
+            if (fd == STDIN_FILENO) lseek(fd, 0, SEEK_END);
+            else close(fd);
+
+            return info.st_size;
+        }
+    }
+
+    long long length = 0, capacity = 1 << 16;
+    line = malloc(capacity);
+    FAIL_IF(line == NULL, 2, "Error: unable to allocate memory.\n");
+
+    for (;;)
+    {
+        if (length == capacity)
         {
-            error_point = index;
-            count++;
+            capacity *= 2;
+            line = realloc(line, capacity);
+            FAIL_IF(line == NULL, 2, "Error: unable to allocate memory.\n");
         }
-        else if (line[index] == ']') count--;
 
-        if (count < 0) return index;
+        ssize_t got = read(fd, line + length, capacity - length);
+
+        if (got < 0 && errno == EINTR) continue;
+        FAIL_IF(got < 0, 2, "Error: unable to read [%s].\n", filename);
+        if (got == 0) break;
+
+        length += got;
     }
 
-    return (count != 0) ? error_point : -1;
+    if (fd != STDIN_FILENO) close(fd);
+    return length;
 }
 
 long long get_line_length(char *line) 
@@ -258,34 +820,100 @@ long long get_line_length(char *line)
     return (1ll << 63) - 1; // if this causes a warning just ignore it <3
 }
 
-long long get_file_length(char *filename)
+// hands an option to the context, anything it doesn't take is a usage error
+void set_option(const char *name, const char *value)
+{
+    FAIL_IF(!bf_option(bf, name, value), 1, "Error: bad value for --%s [%s].\n", name, value);
+    options[option_count++] = (OPTION) {name, value};
+}
+
+// --jobs: 1 to JOBS_MAX threads, anything else is a usage error
+long long get_jobs(const char *text, const char *program)
 {
-    struct stat buffer;
-    stat(filename, &buffer);
-    return buffer.st_size;
+    char *end;
+    errno = 0;
+    long long count = strtoll(text, &end, 10);
+
+    if (end == text || *end != '\0' || errno == ERANGE || count < 1 || count > JOBS_MAX) show_usage(program);
+    return count;
+}
+
+/*
+ * a context for a --batch or --serve worker, with the command line's options. nobody
+ * watches its output as it is printed, so full buffers unless --flush says otherwise.
+ */
+BF *make_worker(void)
+{
+    BF *worker = bf_create();
+
+    bf_option(worker, "flush", "full");
+    if (cache) bf_option(worker, "cache-dir", cache_dir);
+    for (int i = 0; i < option_count; i++) bf_option(worker, options[i].name, options[i].value);
+
+    return worker;
 }
 
-int get_op(char c)
+// only whole files are cached, lines typed at the prompt are not worth it
+void init_cache(void)
 {
-    switch(c) 
+    static char default_dir[PATH_MAX];
+    const char *base = getenv("XDG_CACHE_HOME");
+
+    if (!cache) return;
+
+    if (cache_dir == NULL && (base != NULL || getenv("HOME") != NULL))
     {
-        case '+': return OP_ADDN;
-        case '-': return OP_SUBN;
-        case '>': return OP_MOVR;
-        case '<': return OP_MOVL;
-        case '.': return OP_PRNT;
-        case ',': return OP_SCAN;
-        case '[': return OP_JMPL;
-        case ']': return OP_JMPR;
-        default:  return OP_NULL;
+        if (base != NULL) snprintf(default_dir, PATH_MAX, "%s/bf", base);
+        else snprintf(default_dir, PATH_MAX, "%s/.cache/bf", getenv("HOME"));
+        cache_dir = default_dir;
     }
+
+    bf_option(bf, "cache-dir", cache_dir);
+}
+
+void show_usage(const char *program)
+{
+    FAIL(1, "Usage:\n"
+            "%s [options]        - run brainf code interactively.\n"
+            "%s [options] [file] - run brainf code from a script, - reads it from stdin.\n"
+            "%s --batch [options] [file] [inputs...] - run a script over every input, writing\n"
+            "                      each one's output to the input's name plus .out.\n"
+            "%s --serve=PATH [options] - run scripts sent to a unix socket at PATH.\n\n"
+            "Options:\n"
+            "  --engine=switch   - dispatch with a switch statement (default).\n"
+            "  --engine=threaded - dispatch with computed goto.\n"
+            "  --engine=jit      - compile to x86-64 machine code, --jit for short.\n"
+            "  --engine=tiered   - interpret, compiling hot loops in the background.\n"
+            "  --engine=packed   - interpret a variable-length encoding of the bytecode.\n"
+            "  --tier-threshold=N - loop iterations before a loop is compiled (1000).\n"
+            "  --tape-size=N     - most cells the tape can grow to (268435456).\n"
+            "  --max-steps=N     - stop a run once its loops have gone round N times (exit code 5).\n"
+            "  --timeout=S       - stop a run once it has taken S seconds (exit code 6).\n"
+            "  --flush=full|line|read - write output when the buffer fills, after each newline\n"
+            "                      or before each read (line on a terminal, full otherwise).\n"
+            "  --eof=unchanged|0|255 - what , stores once the input runs out (255).\n"
+            "  -O0, -O1          - disable or enable all optimization passes (default -O1).\n"
+            "  --passes=a,b,...  - run only the listed passes (fold, clear, mul, scan, dead, offset).\n"
+            "  --dump            - print the bytecode instead of running it.\n"
+            "  --profile         - count every instruction run, then print the loops that ran\n"
+            "                      the most to stderr. slower than running normally.\n"
+            "  --sample=FILE     - sample where the run is on a timer and write it to FILE as\n"
+            "                      folded stacks for flamegraph.pl and the like. only the jit\n"
+            "                      engine places samples finer than the loop they are in.\n"
+            "  --sample-rate=HZ  - samples a second of cpu time --sample takes (997).\n"
+            "  --cache-dir=DIR   - keep compiled scripts in DIR ($XDG_CACHE_HOME/bf or ~/.cache/bf).\n"
+            "  --no-cache        - always compile, and don't write to the cache.\n"
+            "  --jobs=N          - threads --batch and --serve run on, 1 to 1024 (one per core).\n"
+            "  --fork            - with --batch, run each input in a child process forked from\n"
+            "                      one that compiled the script, and print what each used.\n\n",
+            program, program, program, program);
 }
 
-void show_error(const long long error_point, const char *line)
+void show_error(const long long error_point, const char *line, long long length)
 {
     printf("Error at character %lli\n", error_point);
 
-    long long start_point = max(0, error_point - 10), end_point = error_point + 10;
+    long long start_point = max(0, error_point - 10), end_point = min(error_point + 10, length);
 
     for (long long i = start_point; i < end_point && line[i] != '\0'; i++) 
         printf("%c", line[i]);
@@ -298,19 +926,16 @@ void show_error(const long long error_point, const char *line)
 
 void free_mem(void) 
 {
-    // printf("free_mem bytecode=%p\n", bytecode);
-    if (line != NULL) { 
-        free(line);
-        line = NULL;
-    }
+    bf_destroy(bf);
+    bf = NULL;
 
-    if (rptr != NULL) { 
-        fclose(rptr);
-        rptr = NULL;
-    }
+    free(options);
+    options = NULL;
 
-    if (bytecode != NULL) { 
-        free(bytecode);
-        bytecode = NULL;
+    if (line != NULL) { 
+        if (line_mapped > 0) munmap(line, line_mapped);
+        else free(line);
+        line = NULL;
+        line_mapped = 0;
     }
 }
@@ -0,0 +1,2926 @@
+#ifdef __linux__
+#define _GNU_SOURCE // memrchr for scan_left, REG_RIP for sample_tick to find where in jit code a run was
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <stdint.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <errno.h>
+#include <setjmp.h>
+#include <time.h>
+#include <sys/time.h>
+#include <stdatomic.h>
+
+#if defined(__x86_64__) && !defined(_WIN32)
+#include <pthread.h>
+#endif
+
+#if defined(__x86_64__) && defined(__linux__)
+#include <ucontext.h>
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "libbf.h"
+
+
+typedef unsigned char byte;
+
+/* BYTECODE */
+
+enum OPS {
+    OP_ADDN, // +
+    OP_SUBN, // -
+    OP_MOVL, // <
+    OP_MOVR, // >
+    OP_JMPL, // [
+    OP_JMPR, // ]
+    OP_SCAN, // ,
+    OP_PRNT, // .
+    OP_SETC, // [-] followed by val +
+    OP_MULA, // cell at off += cell * val
+    OP_SKPR, // [>] moving val cells at a time
+    OP_SKPL, // [<] moving val cells at a time
+    OP_HALT, // end of bytecode
+    OP_NULL  // non-keywords
+};
+
+typedef struct {
+    int OP_type;
+    int off;             // offset from the tape index the op applies to
+    long long val;       // repeat count, or the matching bracket for OP_JMPL/OP_JMPR
+    const void *handler; // label address used by the threaded engine
+} INS;
+
+/* INTERMEDIATE REPRESENTATION */
+
+typedef struct {
+    int op;         // one of OPS
+    long long val;  // operand: repeat count or amount
+    long long off;  // offset from the tape index the op applies to
+    long long link; // matching bracket for OP_JMPL/OP_JMPR, -1 otherwise
+    long long src;  // where in the source the first character it came from is
+} NODE;
+
+typedef struct {
+    NODE *nodes;
+    long long length, capacity;
+} IR;
+
+// an optimization pass rewrites the ir in place, links are rebuilt after each one
+typedef struct {
+    const char *name;
+    void (*run)(IR *code);
+} PASS;
+
+/* TAPE */
+
+// reserved up front, cells are committed as the program touches them
+typedef struct {
+    unsigned char *base;  // start of the reservation, guard pages included
+    size_t size;          // bytes reserved
+    long long page;
+    long long committed;  // cells from arr[0] that can be used
+    long long limit;      // cells the tape can grow to
+} TAPE;
+
+#define TAPE_LIMIT (1ll << 28) // default for --tape-size
+#define TAPE_CHUNK (1ll << 16) // committed to begin with
+#define TAPE_GUARD (1ll << 30) // reserved on both ends, folded moves can jump far past the edge
+#define OFF_MAX (TAPE_GUARD / 2) // furthest the offset pass lets an op reach, well inside the guard
+#define SCAN_SHORT 8           // cells a scan looks at one by one before it sets up the window
+
+/* OUTPUT */
+
+enum FLUSH {
+    FLUSH_FULL, // when the buffer fills
+    FLUSH_LINE, // after every newline
+    FLUSH_READ  // before every ,
+};
+
+// what . prints is collected here and written with write(2) instead of going through stdio
+typedef struct {
+    unsigned char data[1 << 16];
+    long long length;
+    int policy;       // one of FLUSH
+    bool interactive; // input is a terminal, so , always flushes before it waits
+    int fd;           // stdout, or what bf_run_fds was given
+    unsigned char *sink; // the caller's buffer during bf_run_buffers, NULL for stdout
+    size_t sink_length, sink_capacity;
+    BF_WRITE write;      // takes the output instead during bf_run_stream
+    void *write_context;
+} OUTPUT;
+
+#define OUT_IOV 16 // most chunks handed to one writev
+
+/* INPUT */
+
+/*
+ * what , reads: all of stdin mapped when it is a regular file, a block at a time otherwise,
+ * or the caller's buffer during bf_run_buffers
+ */
+typedef struct {
+    const unsigned char *data;
+    long long length, pos;
+    int fd;      // stdin, or what bf_run_fds was given
+    bool ready;  // set up by in_init or bf_run_buffers
+    bool fixed;  // data is all there is, nothing more to read
+    bool mapped; // data is the whole of stdin, unmapped with the context
+    bool stdio;  // the host reads lines from stdin too, so go through getchar
+    void (*eof)(unsigned char *cell); // what , does once the input runs out
+    unsigned char buffer[1 << 16];
+} INPUT;
+
+/* CACHE */
+
+/*
+ * a compiled program on disk: this header followed by `length` + 1 instructions, OP_HALT
+ * included. handler fields are left 0 and filled in after loading.
+ */
+typedef struct {
+    char magic[4];    // "BFC" and a 0
+    uint32_t version; // CACHE_VERSION
+    uint64_t key;     // cache_key of the source and settings it was compiled from
+    int64_t source;   // bytes of source
+    int64_t length;   // instructions, OP_HALT not counted
+    int64_t lines;    // lines of source
+} CACHE_HEADER;
+
+// the header is followed by the bytecode and OP_HALT, then the position map: a source
+// offset an instruction and OP_HALT's -1, then the offset every line starts at. the version
+// is bumped whenever that, the bytecode or what a pass emits changes, and it is part of
+// every key so a newer bf never trusts bytecode an older one wrote
+#define CACHE_VERSION 4
+
+/* ENGINES */
+
+enum ENGINES {
+    ENGINE_SWITCH,   // switch on OP_type
+    ENGINE_THREADED, // computed goto (direct threading)
+    ENGINE_JIT,      // native x86-64 code
+    ENGINE_TIERED,   // switch, with hot loops jit compiled in the background
+    ENGINE_PACKED    // switch over a variable-length encoding of the bytecode
+};
+
+/*
+ * packed bytecode: a byte of opcode, the low 4 bits are OPS and PACK_OFF says an offset
+ * follows as a zigzag varint. then the operand as a varint, except [ and ], which take the
+ * position they jump to as 4 bytes so each instruction's size is known before layout.
+ */
+#define PACK_OP  0x0f
+#define PACK_OFF 0x10
+
+// native code being written by the jit, it is mapped executable once it is done
+typedef struct {
+    unsigned char *code;
+    size_t length, capacity;
+    long long *starts; // where each instruction's code starts, for sample_tick
+} JIT;
+
+#define JIT_INS_SIZE  64 // the most bytes one instruction compiles to
+#define JIT_JMPL_SIZE  9 // cmp + je rel32
+
+#if defined(__x86_64__) && !defined(_WIN32)
+
+enum TIER_STATES { TIER_COLD, TIER_QUEUED, TIER_READY };
+
+// one per instruction, only the entries of [ are used
+typedef struct {
+    long long hits;   // back-edges taken, only touched by the interpreter
+    atomic_int state; // TIER_READY is set by the compiler thread once jit is done
+    JIT jit;
+} TIER;
+
+// loops waiting for the compiler thread, queued under `lock`
+typedef struct {
+    TIER *loops;
+    long long *queue;
+    long long queued, compiled;
+    bool done;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_t thread;
+} TIERING;
+
+#endif
+
+/* BUDGETS */
+
+// loop passes between looks at the clock when only --timeout is set
+#define BUDGET_CHECK (1ll << 16)
+
+/* CONTEXT */
+
+// a compiled program, never written once bf_compile returns, so any number of contexts can run it
+struct BF_PROGRAM {
+    INS *bytecode;
+    long long length;
+    long long mapped; // bytes mapped from the cache around `bytecode`, 0 when it is malloc'd
+    unsigned long long serial; // tells programs apart, even one allocated where a freed one was
+
+    // the position map, kept apart from the bytecode so the engines never load it
+    long long *positions;      // the source offset each instruction came from, -1 after the last
+    long long *lines;          // the offset each line of the source starts at, lines[0] is 0
+    long long line_count;
+};
+
+/*
+ * one interpreter: its settings and everything running a program touches. contexts
+ * share nothing, so any number of them can run at once, one per thread.
+ */
+struct BF {
+    // settings, read by bf_compile and bf_run
+    int engine;
+    unsigned passes;          // bit i turns on passes[i]
+    long long tier_threshold; // back-edges before the tiered engine compiles a loop
+    long long tape_limit;
+    char *cache_dir;          // where compiled programs go, NULL for no cache
+    long long max_steps;      // loop passes a run may take, 0 for no limit
+    double timeout;           // seconds a run may take, 0 for no limit
+    bool profile;             // run on run_profile whatever the engine, see bf_profile
+    long long sample_rate;    // SIGPROF ticks a second of cpu time, 0 for none, see bf_samples
+
+    // the run, the tape and index carry over from one bf_run to the next
+    const BF_PROGRAM *program; // what is running, NULL between runs
+    int status;                // one of BF_STATUS
+    byte *arr; // cell 0, points into `tape`
+    long long index;
+    TAPE tape;
+    OUTPUT out;
+    INPUT in;
+    sigjmp_buf stop;     // where a run that can't go on leaves the engine for, see bf_run
+    long long fuel;      // loop passes until the budget is looked at again, see budget_spent
+    long long fueled;    // what fuel was last set to
+    long long steps;     // loop passes before the last refuel
+    long long deadline;  // CLOCK_MONOTONIC nanoseconds the run has to end by, 0 for none
+    long long stopped_at; // instruction a budget or, in jit code, the tape stopped the run at, -1 otherwise
+    JIT jit;             // run_jit's code for the `kept` program, reused by its next runs
+    byte *packed;        // run_packed's code, likewise
+    unsigned long long kept; // serial of the program jit and packed were made from, 0 for none
+    bool kept_budget;        // whether jit counts loop passes, see jit_compile
+    long long *counts;       // run_profile's count of each instruction of the `counted` program
+    unsigned long long counted;
+    long long *packed_at;    // where each instruction starts in `packed`, for sample_tick
+    volatile long long at;   // the bracket the engine last went through, run_packed's offset of it,
+                             // only kept up while sampling so other runs skip the stores
+    long long *hits;         // sample_tick's samples of the `sampled` program, see bf_samples
+    unsigned long long sampled;
+#if defined(__x86_64__) && !defined(_WIN32)
+    TIERING tiering;
+#endif
+};
+
+/* PROTOTYPES */
+
+static long long run_switch(BF *bf, long long index);
+static long long run_threaded(BF *bf, long long index);
+static long long run_jit(BF *bf, long long index);
+static long long run_tiered(BF *bf, long long index);
+static long long run_packed(BF *bf, long long index);
+static long long run_profile(BF *bf, long long index);
+static void      run_abort(BF *bf);
+static void      code_make(BF *bf);
+static void      code_drop(BF *bf);
+
+// --max-steps and --timeout, charged a loop pass at a time at every ]
+static bool budget_spent(BF *bf);
+static void budget_stop(BF *bf, long long at);
+static void budget_refuel(BF *bf);
+static long long clock_now(void);
+
+static unsigned char *make_packed(BF *bf, long long *packed_length);
+static long long      pack_size(const INS *ins);
+static unsigned char *pack_varint(unsigned char *at, unsigned long long value);
+static long long      pack_index(const unsigned char *code, const unsigned char *at);
+
+#if defined(__x86_64__) && !defined(_WIN32)
+static void  tier_start(BF *bf);
+static void  tier_stop(BF *bf);
+static void  tier_queue(BF *bf, long long start);
+static void *tier_worker(void *context);
+
+static JIT  jit_compile(BF *bf, long long start, long long end);
+static void emit_bytes(JIT *jit, const unsigned char *bytes, size_t count);
+static void emit_imm32(JIT *jit, int32_t imm);
+static void emit_imm64(JIT *jit, int64_t imm);
+static void emit_call(JIT *jit, void *fn);
+static void jit_patch(JIT *jit, size_t at, int32_t imm);
+#endif
+
+// called from jit code, they work on bf_current
+static void jit_print(unsigned char *cell, long long count);
+static void jit_read(unsigned char *cell, long long count);
+static void jit_budget(long long at);
+static unsigned char *jit_scan_right(unsigned char *cell, long long stride);
+static unsigned char *jit_scan_left(unsigned char *cell, long long stride);
+
+// buffered output and the input side of it
+static void out_put(BF *bf, unsigned char c, long long count);
+static void out_flush(BF *bf);
+static void out_drain(BF *bf, struct iovec *iov, int count);
+static void in_get(BF *bf, unsigned char *cell, long long count);
+static void in_init(BF *bf);
+static bool in_refill(BF *bf);
+
+// the eof option's behaviors
+static void in_eof_unchanged(unsigned char *cell);
+static void in_eof_zero(unsigned char *cell);
+static void in_eof_max(unsigned char *cell);
+
+static void tape_init(BF *bf);
+static void tape_reset(BF *bf);
+static void tape_fault(int sig, siginfo_t *info, void *context);
+static void fault_init(void);
+
+// the sampler: SIGPROF finds the instruction each run is at
+static void sample_start(BF *bf);
+static void sample_stop(BF *bf);
+static void sample_tick(int sig, siginfo_t *info, void *context);
+static long long sample_find(const long long *starts, long long count, long long offset);
+static long long engine_at(BF *bf, void *context);
+
+// helpers for OP_SKPR and OP_SKPL, they return the index of the 0 cell they stop on
+static long long scan_right(BF *bf, long long index, long long stride);
+static long long scan_left(BF *bf, long long index, long long stride);
+static unsigned long long zero_mask(const unsigned char *cells);
+
+
+static long long make_ir(IR *code, const char *line, long long length, long long *error_point);
+static void      link_ir(IR *code);
+static void      run_passes(BF *bf, IR *code);
+static long long make_bytecode(BF_PROGRAM *program, IR *code, const char *source, long long length);
+static void      make_lines(BF_PROGRAM *program, const char *source, long long length);
+static void      program_place(const BF_PROGRAM *program, long long pos, long long *line, long long *column);
+
+// optimization passes, run in the order of `passes`
+static void pass_fold(IR *code);
+static void pass_clear(IR *code);
+static void pass_mul(IR *code);
+static void pass_scan(IR *code);
+static void pass_dead(IR *code);
+static void pass_offset(IR *code);
+
+// compiled bytecode kept on disk between runs, see CACHE_HEADER
+static uint64_t  cache_key(BF *bf, const char *source, long long length);
+static void      cache_path(BF *bf, char *path, uint64_t key);
+static long long cache_load(BF *bf, BF_PROGRAM *program, uint64_t key, long long length);
+static void      cache_store(BF *bf, const BF_PROGRAM *program, uint64_t key, long long length);
+static int get_op(char c);
+static int get_engine(const char *name);
+static int get_flush(const char *name);
+static void (*get_eof(const char *name))(unsigned char *cell);
+static long long get_count(const char *text);
+static double get_seconds(const char *text);
+static bool set_passes(BF *bf, const char *names);
+
+/* MACROS */
+
+#define FAIL(code, ...) { printf(__VA_ARGS__); exit(code); }
+#define FAIL_IF(cond, code, ...) if (cond) { FAIL(code, __VA_ARGS__); }
+
+// appends the listed bytes to the jit's code
+#define EMIT(jit, ...) emit_bytes(jit, (const byte []) {__VA_ARGS__}, sizeof((const byte []) {__VA_ARGS__}))
+
+#ifndef _WIN32
+#define max(a, b) ((a > b) ? a : b)
+#define min(a, b) ((a < b) ? a : b)
+#endif
+
+/* GLOBALS */
+
+// label table published by run_threaded, the same for every context. any thread compiling
+// may be the first, so it is atomic
+static const void **_Atomic handlers = NULL;
+
+// the context running on this thread, for tape_fault and the functions jit code calls
+static _Thread_local BF *bf_current = NULL;
+
+static atomic_ullong program_serial = 0; // the last serial bf_compile handed out
+
+static PASS passes[] = {
+    {"fold", pass_fold},
+    {"clear", pass_clear},
+    {"mul", pass_mul},
+    {"scan", pass_scan},
+    {"dead", pass_dead},
+    {"offset", pass_offset}
+};
+
+#define PASS_COUNT (int) (sizeof(passes) / sizeof(passes[0]))
+
+static const char *op_names[] = {
+    [OP_ADDN] = "ADDN", [OP_SUBN] = "SUBN", [OP_MOVL] = "MOVL", [OP_MOVR] = "MOVR",
+    [OP_JMPL] = "JMPL", [OP_JMPR] = "JMPR", [OP_SCAN] = "SCAN", [OP_PRNT] = "PRNT",
+    [OP_SETC] = "SETC", [OP_MULA] = "MULA", [OP_SKPR] = "SKPR", [OP_SKPL] = "SKPL",
+    [OP_HALT] = "HALT", [OP_NULL] = "NULL"
+};
+
+/*
+ * lexes `line` into `code`, merging runs of the same op, and returns the node count.
+ * brackets are matched with a stack in the same pass, so a bad loop returns -1
+ * with error_point set to the offending bracket in `line`.
+ */
+static long long make_ir(IR *code, const char *line, long long length, long long *error_point) 
+{
+    code->capacity = 64;
+    code->length = 0;
+    code->nodes = malloc(sizeof(NODE) * code->capacity);
+    FAIL_IF(code->nodes == NULL, 2, "Error: unable to allocate memory.\n");
+
+    // unmatched '[' so far: where it is in the ir and in the source
+    typedef struct { long long node, src; } BRACKET;
+
+    long long depth = 0, max_depth = 64;
+    BRACKET *stack = malloc(sizeof(BRACKET) * max_depth);
+    FAIL_IF(stack == NULL, 2, "Error: unable to allocate memory.\n");
+
+    *error_point = -1;
+
+    for (long long i = 0, j; i < length; i++) 
+    {
+        int cur_op = get_op(line[i]);
+
+        if (cur_op == OP_NULL) continue;
+
+        if (cur_op != OP_JMPL && cur_op != OP_JMPR && code->length > 0 && code->nodes[code->length - 1].op == cur_op) {
+            code->nodes[code->length - 1].val++;
+            continue;
+        }
+
+        if (code->length == code->capacity) {
+            code->capacity *= 2;
+            code->nodes = realloc(code->nodes, sizeof(NODE) * code->capacity);
+            FAIL_IF(code->nodes == NULL, 2, "Error: unable to allocate memory.\n");
+        }
+
+        switch(cur_op)
+        {
+            case OP_JMPL:
+                if (depth == max_depth) {
+                    max_depth *= 2;
+                    stack = realloc(stack, sizeof(BRACKET) * max_depth);
+                    FAIL_IF(stack == NULL, 2, "Error: unable to allocate memory.\n");
+                }
+                stack[depth++] = (BRACKET) {code->length, i};
+
+                code->nodes[code->length++] = (NODE) {OP_JMPL, 0, 0, -1, i};
+                break;
+            case OP_JMPR:
+                if (depth == 0) {
+                    *error_point = i;
+                    break;
+                }
+                j = stack[--depth].node;
+                code->nodes[j].link = code->length;
+
+                code->nodes[code->length++] = (NODE) {OP_JMPR, 0, 0, j, i};
+                break;
+            default:
+                code->nodes[code->length++] = (NODE) {cur_op, 1, 0, -1, i};
+                break;
+        }
+
+        if (*error_point != -1) break;
+    }
+
+    if (*error_point == -1 && depth > 0) *error_point = stack[depth - 1].src;
+    free(stack);
+
+    if (*error_point != -1) {
+        free(code->nodes);
+        code->nodes = NULL;
+        return -1;
+    }
+
+    return code->length;
+}
+
+// re-matches the brackets of an already validated ir after a pass has moved nodes around
+static void link_ir(IR *code)
+{
+    long long depth = 0;
+    long long *stack = malloc(sizeof(long long) * (code->length + 1));
+    FAIL_IF(stack == NULL, 2, "Error: unable to allocate memory.\n");
+
+    for (long long i = 0; i < code->length; i++)
+    {
+        NODE *node = &code->nodes[i];
+
+        if (node->op == OP_JMPL) stack[depth++] = i;
+        else if (node->op == OP_JMPR) {
+            node->link = stack[--depth];
+            code->nodes[node->link].link = i;
+        }
+        else node->link = -1;
+    }
+
+    free(stack);
+}
+
+// runs every enabled pass over the ir in order
+static void run_passes(BF *bf, IR *code)
+{
+    for (int i = 0; i < PASS_COUNT; i++)
+    {
+        if (!(bf->passes & (1u << i))) continue;
+
+        passes[i].run(code);
+        link_ir(code);
+    }
+}
+
+/*
+ * fold: combines neighbouring +/- into one net change (mod 256) and </> into one net move,
+ * dropping whatever cancels out. repeated , and . keep their count.
+ */
+static void pass_fold(IR *code)
+{
+    long long length = 0;
+
+    for (long long i = 0; i < code->length; i++)
+    {
+        NODE node = code->nodes[i];
+        NODE *prev = (length > 0) ? &code->nodes[length - 1] : NULL;
+
+        bool arith = (node.op == OP_ADDN || node.op == OP_SUBN);
+        bool move  = (node.op == OP_MOVL || node.op == OP_MOVR);
+
+        if (prev != NULL && prev->off == node.off &&
+            ((arith && (prev->op == OP_ADDN || prev->op == OP_SUBN)) || (move && (prev->op == OP_MOVL || prev->op == OP_MOVR))))
+        {
+            long long sum = ((prev->op == OP_ADDN || prev->op == OP_MOVR) ? prev->val : -prev->val) 
+                          + ((node.op == OP_ADDN || node.op == OP_MOVR) ? node.val : -node.val);
+
+            if (arith) sum = ((sum % 256) + 256) % 256;
+
+            if (sum == 0) length--;
+            else if (arith) *prev = (NODE) {(sum <= 128) ? OP_ADDN : OP_SUBN, (sum <= 128) ? sum : 256 - sum, node.off, -1, prev->src};
+            else *prev = (NODE) {(sum > 0) ? OP_MOVR : OP_MOVL, (sum > 0) ? sum : -sum, 0, -1, prev->src};
+        }
+        else if (prev != NULL && prev->op == node.op && prev->off == node.off && (node.op == OP_SCAN || node.op == OP_PRNT)) 
+            prev->val += node.val;
+        else code->nodes[length++] = node;
+    }
+
+    code->length = length;
+}
+
+#define IS_ARITH(node) (((node).op == OP_ADDN || (node).op == OP_SUBN) && (node).off == 0)
+
+/*
+ * clear: turns [-] and [+] into OP_SETC. any odd step reaches 0, so [---] counts too.
+ * the +/- run before the loop is overwritten and the one after it becomes the constant.
+ */
+static void pass_clear(IR *code)
+{
+    long long length = 0;
+
+    for (long long i = 0; i < code->length; i++)
+    {
+        NODE node = code->nodes[i];
+
+        if (node.op != OP_JMPL || node.link != i + 2 || !IS_ARITH(code->nodes[i + 1]) || code->nodes[i + 1].val % 2 == 0) {
+            code->nodes[length++] = node;
+            continue;
+        }
+
+        while (length > 0 && (IS_ARITH(code->nodes[length - 1]) || code->nodes[length - 1].op == OP_SETC)) length--;
+
+        i += 2;
+
+        long long val = 0;
+        if (i + 1 < code->length && IS_ARITH(code->nodes[i + 1])) {
+            i++;
+            val = (code->nodes[i].op == OP_ADDN) ? code->nodes[i].val : 256 - code->nodes[i].val % 256;
+        }
+
+        code->nodes[length++] = (NODE) {OP_SETC, val % 256, 0, -1, node.src};
+    }
+
+    code->length = length;
+}
+
+/*
+ * mul: turns a balanced loop of +-<> that steps its own cell by one, like [->+>++<<],
+ * into one OP_MULA per cell it adds to followed by OP_SETC 0.
+ * the MULAs are skipped when the cell is already 0, as the loop would be, so they never
+ * touch cells the program doesn't reach.
+ */
+static void pass_mul(IR *code)
+{
+    long long length = 0;
+
+    // net change per touched cell of the current loop, targets[0] is the loop's own cell
+    NODE *targets = malloc(sizeof(NODE) * (code->length + 1));
+    FAIL_IF(targets == NULL, 2, "Error: unable to allocate memory.\n");
+
+    for (long long i = 0; i < code->length; i++)
+    {
+        NODE node = code->nodes[i];
+        long long end = node.link, pos = 0, target_count = 1, j;
+
+        targets[0] = (NODE) {OP_MULA, 0, 0, -1, node.src};
+
+        for (j = i + 1; node.op == OP_JMPL && j < end; j++)
+        {
+            NODE body = code->nodes[j];
+
+            if (body.op == OP_MOVR) pos += body.val;
+            else if (body.op == OP_MOVL) pos -= body.val;
+            else if (IS_ARITH(body)) {
+                long long k = 0;
+                while (k < target_count && targets[k].off != pos) k++;
+                if (k == target_count) targets[target_count++] = (NODE) {OP_MULA, 0, pos, -1, node.src};
+
+                targets[k].val += (body.op == OP_ADDN) ? body.val : -body.val;
+            }
+            else break;
+        }
+
+        long long step = ((targets[0].val % 256) + 256) % 256;
+
+        if (node.op != OP_JMPL || j < end || pos != 0 || (step != 1 && step != 255)) {
+            code->nodes[length++] = node;
+            continue;
+        }
+
+        for (long long k = 1; k < target_count; k++)
+        {
+            // stepping up by one runs (256 - cell) times, which is -cell mod 256
+            long long factor = (step == 255) ? targets[k].val : -targets[k].val;
+
+            targets[k].val = ((factor % 256) + 256) % 256;
+            if (targets[k].val != 0) code->nodes[length++] = targets[k];
+        }
+
+        i = end;
+
+        long long val = 0;
+        if (i + 1 < code->length && IS_ARITH(code->nodes[i + 1])) {
+            i++;
+            val = (code->nodes[i].op == OP_ADDN) ? code->nodes[i].val : 256 - code->nodes[i].val % 256;
+        }
+
+        code->nodes[length++] = (NODE) {OP_SETC, val % 256, 0, -1, node.src};
+    }
+
+    free(targets);
+    code->length = length;
+}
+
+// scan: turns [>] and [<] with any stride, like mandelbrot's [>>>>>>>>>], into OP_SKPR and OP_SKPL
+static void pass_scan(IR *code)
+{
+    long long length = 0;
+
+    for (long long i = 0; i < code->length; i++)
+    {
+        NODE node = code->nodes[i];
+        NODE *body = &code->nodes[i + 1];
+
+        if (node.op == OP_JMPL && node.link == i + 2 && (body->op == OP_MOVR || body->op == OP_MOVL)) {
+            code->nodes[length++] = (NODE) {(body->op == OP_MOVR) ? OP_SKPR : OP_SKPL, body->val, 0, -1, node.src};
+            i += 2;
+        }
+        else code->nodes[length++] = node;
+    }
+
+    code->length = length;
+}
+
+// dead: drops loops that start where the cell is known to be 0, right after a loop, clear or scan
+static void pass_dead(IR *code)
+{
+    long long length = 0;
+
+    for (long long i = 0; i < code->length; i++)
+    {
+        NODE *prev = (length > 0) ? &code->nodes[length - 1] : NULL;
+
+        if (code->nodes[i].op == OP_JMPL && prev != NULL && 
+            (prev->op == OP_JMPR || prev->op == OP_SKPR || prev->op == OP_SKPL || 
+             (prev->op == OP_SETC && prev->val == 0 && prev->off == 0))) {
+            i = code->nodes[i].link;
+            continue;
+        }
+
+        code->nodes[length++] = code->nodes[i];
+    }
+
+    code->length = length;
+}
+
+/*
+ * offset: gives every +, -, ., , and clear in a straight line of code the offset of its cell
+ * and moves the pointer once where the line ends, so >+>++<<- runs as 3 ops instead of 6.
+ * loops, scans and multiplies need the real pointer, so they end the line.
+ */
+static void pass_offset(IR *code)
+{
+    long long length = 0, pos = 0, src = 0; // src: where the first move folded into pos is
+
+    for (long long i = 0; i <= code->length; i++)
+    {
+        NODE node = (i < code->length) ? code->nodes[i] : (NODE) {OP_HALT, 0, 0, -1, -1};
+
+        switch (node.op)
+        {
+            case OP_MOVR:
+            case OP_MOVL:
+                if (pos == 0) src = node.src;
+                pos += (node.op == OP_MOVR) ? node.val : -node.val;
+                if (pos > -OFF_MAX && pos < OFF_MAX) continue;
+                break;
+            case OP_ADDN:
+            case OP_SUBN:
+            case OP_SETC:
+            case OP_SCAN:
+            case OP_PRNT:
+                node.off += pos;
+                code->nodes[length++] = node;
+                continue;
+        }
+
+        // every move folded into pos was a node, so this never overtakes i
+        if (pos != 0) code->nodes[length++] = (NODE) {(pos > 0) ? OP_MOVR : OP_MOVL, (pos > 0) ? pos : -pos, 0, -1, src};
+        pos = 0;
+
+        if (i < code->length && node.op != OP_MOVR && node.op != OP_MOVL) code->nodes[length++] = node;
+    }
+
+    code->length = length;
+}
+
+/*
+ * lowers the ir into the program's bytecode and returns its length, the ir is freed. each
+ * node's source offset, which every pass keeps, goes into the position map beside it.
+ */
+static long long make_bytecode(BF_PROGRAM *program, IR *code, const char *source, long long length)
+{
+    INS *bytecode = program->bytecode = malloc(sizeof(INS) * (code->length + 1));
+    long long *positions = program->positions = malloc(sizeof(long long) * (code->length + 1));
+    FAIL_IF(bytecode == NULL || positions == NULL, 2, "Error: unable to allocate memory.\n");
+
+    for (long long i = 0; i < code->length; i++)
+    {
+        NODE *node = &code->nodes[i];
+        positions[i] = node->src;
+
+        if (node->op == OP_JMPL || node->op == OP_JMPR) bytecode[i] = (INS) {node->op, 0, node->link, NULL};
+        else bytecode[i] = (INS) {node->op, node->off, node->val, NULL};
+    }
+
+    long long bytecode_length = code->length;
+    bytecode[bytecode_length] = (INS) {OP_HALT, 0, 0, NULL};
+    positions[bytecode_length] = -1;
+
+    free(code->nodes);
+    code->nodes = NULL;
+
+    make_lines(program, source, length);
+    return bytecode_length;
+}
+
+// where each line of `source` starts, so program_place finds a line without the source
+static void make_lines(BF_PROGRAM *program, const char *source, long long length)
+{
+    long long count = 1;
+    for (const char *c = source; (c = memchr(c, '\n', source + length - c)) != NULL; c++) count++;
+
+    long long *lines = program->lines = malloc(sizeof(long long) * count);
+    FAIL_IF(lines == NULL, 2, "Error: unable to allocate memory.\n");
+
+    lines[0] = 0;
+    program->line_count = 1;
+
+    for (const char *c = source; (c = memchr(c, '\n', source + length - c)) != NULL; c++)
+        lines[program->line_count++] = c - source + 1;
+}
+
+// the 1-based line and column of source offset `pos`
+static void program_place(const BF_PROGRAM *program, long long pos, long long *line, long long *column)
+{
+    long long found = sample_find(program->lines, program->line_count, pos);
+
+    *line = found + 1;
+    *column = pos - program->lines[found] + 1;
+}
+
+
+/* LIBRARY */
+
+// a context with the defaults the command line starts from
+BF *bf_create(void)
+{
+    BF *bf = calloc(1, sizeof(BF));
+    FAIL_IF(bf == NULL, 2, "Error: unable to allocate memory.\n");
+
+    bf->engine = ENGINE_SWITCH;
+    bf->passes = (1u << PASS_COUNT) - 1;
+    bf->tier_threshold = 1000;
+    bf->tape_limit = TAPE_LIMIT;
+
+    // a terminal sees every line as it is printed, anything else gets full buffers
+    bf->out.policy = isatty(STDOUT_FILENO) ? FLUSH_LINE : FLUSH_FULL;
+    bf->out.fd = STDOUT_FILENO;
+    bf->in.fd = STDIN_FILENO;
+    bf->in.eof = in_eof_max; // getchar's EOF stored in a cell, as it always has been
+
+#if defined(__x86_64__) && !defined(_WIN32)
+    pthread_mutex_init(&bf->tiering.lock, NULL);
+    pthread_cond_init(&bf->tiering.wake, NULL);
+#endif
+
+    return bf;
+}
+
+// the names are the command line's long options without the dashes
+bool bf_option(BF *bf, const char *name, const char *value)
+{
+    if (strcmp(name, "cache-dir") == 0)
+    {
+        free(bf->cache_dir);
+        bf->cache_dir = (value != NULL) ? strdup(value) : NULL;
+        return value == NULL || bf->cache_dir != NULL;
+    }
+
+    if (value == NULL) return false;
+
+    if (strcmp(name, "engine") == 0)
+    {
+        int engine = get_engine(value);
+        if (engine == -1) return false;
+        bf->engine = engine;
+    }
+    else if (strcmp(name, "flush") == 0)
+    {
+        int policy = get_flush(value);
+        if (policy == -1) return false;
+        bf->out.policy = policy;
+    }
+    else if (strcmp(name, "eof") == 0)
+    {
+        void (*eof)(byte *cell) = get_eof(value);
+        if (eof == NULL) return false;
+        bf->in.eof = eof;
+    }
+    else if (strcmp(name, "input") == 0)
+    {
+        if (strcmp(value, "stdin") != 0 && strcmp(value, "stdio") != 0) return false;
+        bf->in.stdio = strcmp(value, "stdio") == 0;
+    }
+    else if (strcmp(name, "passes") == 0) return set_passes(bf, value);
+    else if (strcmp(name, "tape-size") == 0)
+    {
+        // a tape of no cells can't run anything
+        long long cells = get_count(value);
+        if (cells <= 0) return false;
+        bf->tape_limit = cells;
+    }
+    else if (strcmp(name, "tier-threshold") == 0 || strcmp(name, "max-steps") == 0 || strcmp(name, "sample-rate") == 0)
+    {
+        long long count = get_count(value);
+        if (count == -1) return false;
+
+        if (strcmp(name, "tier-threshold") == 0) bf->tier_threshold = count;
+        else if (strcmp(name, "max-steps") == 0) bf->max_steps = count;
+        else bf->sample_rate = count;
+    }
+    else if (strcmp(name, "timeout") == 0)
+    {
+        double seconds = get_seconds(value);
+        if (seconds < 0) return false;
+        bf->timeout = seconds;
+    }
+    else if (strcmp(name, "profile") == 0)
+    {
+        if (strcmp(value, "on") != 0 && strcmp(value, "off") != 0) return false;
+        bf->profile = strcmp(value, "on") == 0;
+    }
+    else return false;
+
+    return true;
+}
+
+/*
+ * compiles `source` with the context's passes, or maps it from the cache. returns NULL
+ * with error_point set to the first invalid bracket if the brackets don't match.
+ */
+BF_PROGRAM *bf_compile(BF *bf, const char *source, long long length, long long *error_point)
+{
+    BF_PROGRAM *program = calloc(1, sizeof(BF_PROGRAM));
+    FAIL_IF(program == NULL, 2, "Error: unable to allocate memory.\n");
+
+    if (error_point != NULL) *error_point = -1;
+    program->serial = atomic_fetch_add(&program_serial, 1) + 1;
+
+#ifdef __GNUC__
+    if (atomic_load_explicit(&handlers, memory_order_acquire) == NULL) run_threaded(NULL, 0); // publish label table
+#endif
+
+    bool cached = bf->cache_dir != NULL;
+
+    uint64_t key = cached ? cache_key(bf, source, length) : 0;
+    program->length = cached ? cache_load(bf, program, key, length) : -1;
+
+    if (program->length == -1)
+    {
+        IR code;
+        long long error;
+
+        if (make_ir(&code, source, length, &error) == -1)
+        {
+            if (error_point != NULL) *error_point = error;
+            free(program);
+            return NULL;
+        }
+
+        run_passes(bf, &code);
+        program->length = make_bytecode(program, &code, source, length);
+
+        if (cached) cache_store(bf, program, key, length);
+    }
+
+    // resolve handler addresses up front so the threaded engine never looks at OP_type
+    const void **labels = atomic_load_explicit(&handlers, memory_order_acquire);
+    if (labels != NULL)
+        for (long long i = 0; i <= program->length; i++)
+            program->bytecode[i].handler = labels[program->bytecode[i].OP_type];
+
+    return program;
+}
+
+void bf_free_program(BF_PROGRAM *program)
+{
+    if (program == NULL) return;
+
+    if (program->mapped > 0) munmap((CACHE_HEADER *) program->bytecode - 1, program->mapped);
+    else
+    {
+        free(program->bytecode);
+        free(program->positions);
+        free(program->lines);
+    }
+
+    free(program);
+}
+
+/*
+ * does ahead of time what the first run of `program` would: maps the tape, installs the
+ * fault handler and makes the engine's code. forked processes share all of it.
+ */
+void bf_prepare(BF *bf, const BF_PROGRAM *program)
+{
+    if (bf->tape.base == NULL) tape_init(bf);
+    fault_init();
+
+    bf->program = program;
+    if (bf->engine == ENGINE_JIT || bf->engine == ENGINE_PACKED) code_make(bf);
+    bf->program = NULL;
+}
+
+// runs `program` on the context's tape, starting where the last run left off
+int bf_run(BF *bf, const BF_PROGRAM *program)
+{
+    if (bf->tape.base == NULL) tape_init(bf);
+    if (!bf->in.ready) in_init(bf);
+    fault_init();
+
+    BF *outer = bf_current;
+    bf_current = bf;
+    bf->program = program;
+    bf->status = BF_OK;
+
+    bf->steps = 0;
+    bf->stopped_at = -1;
+    bf->deadline = (bf->timeout > 0) ? clock_now() + (long long) (bf->timeout * 1e9) : 0;
+    budget_refuel(bf);
+    bf->at = -1;
+    if (bf->sample_rate > 0) sample_start(bf);
+
+    // tape_fault and budget_stop come back here, with the status set, to end the run early
+    if (sigsetjmp(bf->stop, 1) != 0)
+    {
+        run_abort(bf);
+        bf->index = 0;
+    }
+    else if (bf->profile) bf->index = run_profile(bf, bf->index);
+    else
+    {
+        switch (bf->engine)
+        {
+            case ENGINE_THREADED:
+                bf->index = run_threaded(bf, bf->index);
+                break;
+            case ENGINE_JIT:
+                bf->index = run_jit(bf, bf->index);
+                break;
+            case ENGINE_TIERED:
+                bf->index = run_tiered(bf, bf->index);
+                break;
+            case ENGINE_PACKED:
+                bf->index = run_packed(bf, bf->index);
+                break;
+            default:
+                bf->index = run_switch(bf, bf->index);
+                break;
+        }
+    }
+
+    if (bf->sample_rate > 0) sample_stop(bf);
+
+    bf->steps += bf->fueled - bf->fuel;
+    out_flush(bf);
+
+    bf->program = NULL;
+    bf_current = outer;
+    return bf->status;
+}
+
+// runs `program` from a blank tape with , reading `input` and . writing to `output`
+int bf_run_buffers(BF *bf, const BF_PROGRAM *program, const unsigned char *input, size_t input_length,
+                   unsigned char *output, size_t output_capacity, size_t *output_length)
+{
+    INPUT *in = &bf->in;
+    OUTPUT *out = &bf->out;
+
+    tape_reset(bf);
+
+    if (in->mapped) munmap((void *) in->data, in->length);
+    in->data = input;
+    in->length = input_length;
+    in->pos = 0;
+    in->ready = in->fixed = true;
+    in->mapped = false;
+    out->interactive = false;
+
+    out->sink = output;
+    out->sink_capacity = output_capacity;
+    out->sink_length = 0;
+
+    int status = bf_run(bf, program);
+
+    if (output_length != NULL) *output_length = out->sink_length;
+    out->sink = NULL;
+    in->ready = false; // a later bf_run sets stdin up again
+
+    return status;
+}
+
+// the same with output going to `write` instead of a buffer
+int bf_run_stream(BF *bf, const BF_PROGRAM *program, const unsigned char *input, size_t input_length,
+                  BF_WRITE write, void *context)
+{
+    OUTPUT *out = &bf->out;
+
+    out->write = write;
+    out->write_context = context;
+
+    int status = bf_run_buffers(bf, program, input, input_length, NULL, 0, NULL);
+
+    out->write = NULL;
+    return status;
+}
+
+// the same from file descriptors, which the caller opened and closes
+int bf_run_fds(BF *bf, const BF_PROGRAM *program, int input, int output)
+{
+    INPUT *in = &bf->in;
+    OUTPUT *out = &bf->out;
+
+    tape_reset(bf);
+
+    if (in->mapped) munmap((void *) in->data, in->length);
+    in->mapped = in->ready = false;
+    in->fd = input;
+    out->fd = output;
+
+    int status = bf_run(bf, program);
+
+    if (in->mapped) munmap((void *) in->data, in->length);
+    in->mapped = in->ready = false;
+    in->fd = STDIN_FILENO;
+    out->fd = STDOUT_FILENO;
+
+    return status;
+}
+
+// flushes what the context still has to print and frees all of it
+void bf_destroy(BF *bf)
+{
+    if (bf == NULL) return;
+
+    out_flush(bf);
+    code_drop(bf);
+    free(bf->counts);
+    free(bf->hits);
+
+    if (bf->tape.base != NULL) munmap(bf->tape.base, bf->tape.size);
+    if (bf->in.mapped) munmap((void *) bf->in.data, bf->in.length);
+    free(bf->cache_dir);
+
+#if defined(__x86_64__) && !defined(_WIN32)
+    pthread_mutex_destroy(&bf->tiering.lock);
+    pthread_cond_destroy(&bf->tiering.wake);
+#endif
+
+    free(bf);
+}
+
+// stops whatever the engine had going when tape_fault or a budget cut its run short
+static void run_abort(BF *bf)
+{
+#if defined(__x86_64__) && !defined(_WIN32)
+    if (bf->tiering.loops != NULL) tier_stop(bf);
+#endif
+}
+
+/*
+ * makes the jit or packed code for the running program, unless the context still has it
+ * from running the same program before. jit code points at the context's own fuel, so
+ * it is only ever reused by the context that made it.
+ */
+static void code_make(BF *bf)
+{
+    bool budget = bf->max_steps > 0 || bf->timeout > 0;
+
+    if (bf->kept != bf->program->serial || bf->kept_budget != budget) code_drop(bf);
+
+    bf->kept = bf->program->serial;
+    bf->kept_budget = budget;
+
+#if defined(__x86_64__) && !defined(_WIN32)
+    if (bf->engine == ENGINE_JIT && bf->jit.code == NULL) bf->jit = jit_compile(bf, 0, bf->program->length);
+#endif
+
+    if (bf->engine == ENGINE_PACKED && bf->packed == NULL)
+    {
+        long long packed_length;
+        bf->packed = make_packed(bf, &packed_length);
+    }
+}
+
+static void code_drop(BF *bf)
+{
+    if (bf->jit.code != NULL) munmap(bf->jit.code, bf->jit.capacity);
+    free(bf->jit.starts);
+    bf->jit.code = NULL;
+    bf->jit.starts = NULL;
+
+    free(bf->packed);
+    free(bf->packed_at);
+    bf->packed = NULL;
+    bf->packed_at = NULL;
+    bf->kept = 0;
+}
+
+/*
+ * every ] an engine goes through burns a unit of fuel, and only running out calls this:
+ * it charges what was burned to the run and says whether the run is over budget, with
+ * bf->status set to which one, or refuels it.
+ */
+static bool budget_spent(BF *bf)
+{
+    bf->steps += bf->fueled;
+    bf->fueled = 0;
+
+    if (bf->max_steps > 0 && bf->steps >= bf->max_steps) bf->status = BF_STEP_LIMIT;
+    else if (bf->deadline > 0 && clock_now() >= bf->deadline) bf->status = BF_TIME_LIMIT;
+    else
+    {
+        budget_refuel(bf);
+        return false;
+    }
+
+    return true;
+}
+
+// ends an over budget run at instruction `at`, bf_run picks up from there
+static void budget_stop(BF *bf, long long at)
+{
+    bf->stopped_at = at;
+    siglongjmp(bf->stop, 1);
+}
+
+// what is left of --max-steps, at most BUDGET_CHECK so --timeout gets to look at the clock
+static void budget_refuel(BF *bf)
+{
+    long long fuel = LLONG_MAX;
+
+    if (bf->max_steps > 0) fuel = bf->max_steps - bf->steps;
+    if (bf->deadline > 0) fuel = min(fuel, BUDGET_CHECK);
+
+    bf->fuel = bf->fueled = fuel;
+}
+
+static long long clock_now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000ll + now.tv_nsec;
+}
+
+long long bf_steps(const BF *bf)
+{
+    return bf->steps;
+}
+
+long long bf_stopped_at(const BF *bf)
+{
+    return bf->stopped_at;
+}
+
+long long bf_position(const BF_PROGRAM *program, long long instruction)
+{
+    if (instruction < 0 || instruction >= program->length) return -1;
+    return program->positions[instruction];
+}
+
+bool bf_place(const BF_PROGRAM *program, long long instruction, long long *line, long long *column)
+{
+    if (instruction < 0 || instruction >= program->length) return false;
+
+    program_place(program, program->positions[instruction], line, column);
+    return true;
+}
+
+/*
+ * prints the `loops` loops of `program` that ran the most instructions themselves, from
+ * what run_profile counted, with what they ran including the loops inside them. a loop's
+ * passes are its ] and its entries the times its [ didn't skip it. `source`, if not NULL,
+ * turns offsets into line:column.
+ */
+void bf_profile(const BF *bf, const BF_PROGRAM *program, const char *source, FILE *stream, int loops)
+{
+    if (bf->counts == NULL || bf->counted != program->serial)
+    {
+        fprintf(stream, "profile: nothing counted for this program.\n");
+        return;
+    }
+
+    const INS *bytecode = program->bytecode;
+    const long long *counts = bf->counts;
+    long long length = program->length;
+
+    // sums[i] is the instructions run before i, so what a loop ran is a subtraction
+    long long *sums = malloc(sizeof(long long) * (length + 1));
+    long long *own = malloc(sizeof(long long) * (length + 1)); // by [, less the loops inside
+    long long *hot = malloc(sizeof(long long) * (loops + 1));
+    FAIL_IF(sums == NULL || own == NULL || hot == NULL, 2, "Error: unable to allocate memory.\n");
+
+    sums[0] = 0;
+    for (long long i = 0; i < length; i++) sums[i + 1] = sums[i] + counts[i];
+
+    #define RAN(start) (sums[bytecode[start].val + 1] - sums[start])
+
+    long long total = max(sums[length], 1), passes = 0, found = 0;
+
+    // the hottest `loops` [ by what they ran themselves, kept sorted by insertion
+    for (long long i = 0; i < length; i++)
+    {
+        if (bytecode[i].OP_type != OP_JMPL || counts[i] == 0) continue;
+        passes += counts[bytecode[i].val];
+
+        own[i] = RAN(i);
+        for (long long j = i + 1; j < bytecode[i].val; j++)
+        {
+            if (bytecode[j].OP_type != OP_JMPL) continue;
+            own[i] -= RAN(j);
+            j = bytecode[j].val;
+        }
+
+        long long k = found;
+        while (k > 0 && own[hot[k - 1]] < own[i]) k--;
+
+        if (k == loops) continue;
+        memmove(hot + k + 1, hot + k, sizeof(long long) * (min(found, loops - 1) - k));
+        hot[k] = i;
+        found = min(found + 1, loops);
+    }
+
+    fprintf(stream, "profile: %lli instructions, %lli loop passes\n", sums[length], passes);
+    fprintf(stream, "%7s %7s %14s %12s %10s  %s\n", "self", "total", "passes", "entries", "at", "loop");
+
+    for (long long k = 0; k < found; k++)
+    {
+        long long start = hot[k], end = bytecode[start].val;
+        long long from = program->positions[start], to = program->positions[end];
+
+        char at[48];
+        long long line, column;
+        program_place(program, from, &line, &column);
+        snprintf(at, sizeof(at), "%lli:%lli", line, column);
+
+        fprintf(stream, "%6.2f%% %6.2f%% %14lli %12lli %10s  ", 100.0 * own[start] / total, 100.0 * RAN(start) / total,
+                counts[end], counts[start] - counts[end], at);
+
+        // the loop as written, cut short past 40 characters
+        int shown = 0;
+        for (long long j = from; source != NULL && j <= to && shown < 40; j++)
+        {
+            if (get_op(source[j]) == OP_NULL) continue;
+            fputc(source[j], stream);
+            shown++;
+        }
+
+        fprintf(stream, "%s\n", (shown == 40) ? "..." : "");
+    }
+
+    #undef RAN
+
+    free(sums);
+    free(own);
+    free(hot);
+}
+
+/*
+ * writes what sample_tick caught as folded stacks, a line per place with its count:
+ * `root`, then the loops it was in from the outermost, each as line:column and its text,
+ * and for jit code the instruction itself. "(runtime)" is jit time spent in the C the
+ * code calls. returns the samples written.
+ */
+long long bf_samples(const BF *bf, const BF_PROGRAM *program, const char *source, const char *root, FILE *stream)
+{
+    if (bf->hits == NULL || bf->sampled != program->serial) return 0;
+
+    const INS *bytecode = program->bytecode;
+    long long length = program->length;
+
+    // loop[i]: the innermost loop holding i, a bracket holds itself. up[i]: what holds the loop at [ i
+    long long *loop = malloc(sizeof(long long) * (length + 1));
+    long long *up = malloc(sizeof(long long) * (length + 1));
+    long long *frames = malloc(sizeof(long long) * (length + 1));
+    FAIL_IF(loop == NULL || up == NULL || frames == NULL, 2, "Error: unable to allocate memory.\n");
+
+    for (long long i = 0, inside = -1; i < length; i++)
+    {
+        if (bytecode[i].OP_type == OP_JMPL)
+        {
+            up[i] = inside;
+            inside = i;
+        }
+
+        loop[i] = (bytecode[i].OP_type == OP_JMPR) ? bytecode[i].val : inside;
+        if (bytecode[i].OP_type == OP_JMPR) inside = up[bytecode[i].val];
+    }
+
+    long long total = 0;
+
+    if (bf->hits[0] > 0) fprintf(stream, "%s;(runtime) %lli\n", root, bf->hits[0]);
+    if (bf->hits[1] > 0) fprintf(stream, "%s %lli\n", root, bf->hits[1]);
+    total += bf->hits[0] + bf->hits[1];
+
+    for (long long i = 0; i < length; i++)
+    {
+        long long hits = bf->hits[i + 2];
+        if (hits == 0) continue;
+
+        long long depth = 0;
+        for (long long k = loop[i]; k != -1; k = up[k]) frames[depth++] = k;
+
+        fputs(root, stream);
+
+        while (depth-- > 0)
+        {
+            long long from = program->positions[frames[depth]], to = program->positions[bytecode[frames[depth]].val];
+            long long line, column;
+            program_place(program, from, &line, &column);
+            fprintf(stream, ";%lli:%lli ", line, column);
+
+            // the loop as written, cut short past 24 characters
+            int shown = 0;
+            for (long long j = from; source != NULL && j <= to && shown < 24; j++)
+            {
+                if (get_op(source[j]) == OP_NULL) continue;
+                fputc(source[j], stream);
+                shown++;
+            }
+            if (shown == 24) fputs("...", stream);
+        }
+
+        // only jit samples land between brackets
+        if (bytecode[i].OP_type != OP_JMPL && bytecode[i].OP_type != OP_JMPR)
+        {
+            long long line, column;
+            program_place(program, program->positions[i], &line, &column);
+            fprintf(stream, ";%lli:%lli %s", line, column, op_names[bytecode[i].OP_type]);
+        }
+
+        fprintf(stream, " %lli\n", hits);
+        total += hits;
+    }
+
+    free(loop);
+    free(up);
+    free(frames);
+    return total;
+}
+
+// executes the bytecode with a switch on every instruction, returns the final index
+static long long run_switch(BF *bf, long long index)
+{
+    const INS *bytecode = bf->program->bytecode;
+    long long bytecode_length = bf->program->length;
+    byte *arr = bf->arr;
+    bool sampling = bf->sample_rate > 0;
+
+    for (long long i = 0; i < bytecode_length; i++)
+    {
+        // printf("code=%i val=%i i=%lli\n", bytecode[i].OP_type, bytecode[i].val, i);
+        switch(bytecode[i].OP_type)
+        {
+            case OP_ADDN:
+                arr[index + bytecode[i].off] += bytecode[i].val;
+                break;
+            case OP_SUBN:
+                arr[index + bytecode[i].off] -= bytecode[i].val;
+                break;
+            case OP_MOVL:
+                index -= bytecode[i].val;
+                break;
+            case OP_MOVR:
+                index += bytecode[i].val;
+                break;
+            case OP_JMPL:
+                if (sampling) bf->at = i;
+                if (arr[index] == 0) i = bytecode[i].val;
+                break;
+            case OP_JMPR:
+                if (sampling) bf->at = i;
+                if (--bf->fuel == 0 && budget_spent(bf)) budget_stop(bf, i);
+                i = bytecode[i].val - 1; // subtract 1 because of i++
+                break;
+            case OP_SCAN:
+                in_get(bf, &arr[index + bytecode[i].off], bytecode[i].val);
+                break;
+            case OP_PRNT:
+                out_put(bf, arr[index + bytecode[i].off], bytecode[i].val);
+                break;
+            case OP_SETC:
+                arr[index + bytecode[i].off] = bytecode[i].val;
+                break;
+            case OP_MULA:
+                if (arr[index] != 0) arr[index + bytecode[i].off] += arr[index] * bytecode[i].val;
+                break;
+            case OP_SKPR:
+                index = scan_right(bf, index, bytecode[i].val);
+                break;
+            case OP_SKPL:
+                index = scan_left(bf, index, bytecode[i].val);
+                break;
+                // case OP_NULL: break;
+        }
+        // for (int j = 0; j < 10; j++) printf("%i ", arr[j]); printf("\nindex=%i\n", index);
+    }
+
+    return index;
+}
+
+/*
+ * run_switch counting every instruction it executes into bf->counts, for bf_profile.
+ * a copy rather than a flag, so the other engines never test for it. the counts add
+ * up over runs of the same program and start again for a different one.
+ */
+static long long run_profile(BF *bf, long long index)
+{
+    const INS *bytecode = bf->program->bytecode;
+    long long bytecode_length = bf->program->length;
+    byte *arr = bf->arr;
+    bool sampling = bf->sample_rate > 0;
+
+    if (bf->counted != bf->program->serial)
+    {
+        free(bf->counts);
+        bf->counts = calloc(bytecode_length + 1, sizeof(long long));
+        FAIL_IF(bf->counts == NULL, 2, "Error: unable to allocate memory.\n");
+        bf->counted = bf->program->serial;
+    }
+
+    long long *counts = bf->counts;
+
+    for (long long i = 0; i < bytecode_length; i++)
+    {
+        counts[i]++;
+
+        switch(bytecode[i].OP_type)
+        {
+            case OP_ADDN:
+                arr[index + bytecode[i].off] += bytecode[i].val;
+                break;
+            case OP_SUBN:
+                arr[index + bytecode[i].off] -= bytecode[i].val;
+                break;
+            case OP_MOVL:
+                index -= bytecode[i].val;
+                break;
+            case OP_MOVR:
+                index += bytecode[i].val;
+                break;
+            case OP_JMPL:
+                if (sampling) bf->at = i;
+                if (arr[index] == 0) i = bytecode[i].val;
+                break;
+            case OP_JMPR:
+                if (sampling) bf->at = i;
+                if (--bf->fuel == 0 && budget_spent(bf)) budget_stop(bf, i);
+                i = bytecode[i].val - 1; // subtract 1 because of i++
+                break;
+            case OP_SCAN:
+                in_get(bf, &arr[index + bytecode[i].off], bytecode[i].val);
+                break;
+            case OP_PRNT:
+                out_put(bf, arr[index + bytecode[i].off], bytecode[i].val);
+                break;
+            case OP_SETC:
+                arr[index + bytecode[i].off] = bytecode[i].val;
+                break;
+            case OP_MULA:
+                if (arr[index] != 0) arr[index + bytecode[i].off] += arr[index] * bytecode[i].val;
+                break;
+            case OP_SKPR:
+                index = scan_right(bf, index, bytecode[i].val);
+                break;
+            case OP_SKPL:
+                index = scan_left(bf, index, bytecode[i].val);
+                break;
+        }
+    }
+
+    return index;
+}
+
+/*
+ * executes the bytecode by jumping straight to each instruction's handler (labels as values),
+ * so every handler ends in its own indirect branch instead of sharing the switch's.
+ * called without a context it only publishes its label table into `handlers`.
+ */
+static long long run_threaded(BF *bf, long long index)
+{
+#ifdef __GNUC__
+    static const void *labels[] = {
+        [OP_ADDN] = &&do_addn,
+        [OP_SUBN] = &&do_subn,
+        [OP_MOVL] = &&do_movl,
+        [OP_MOVR] = &&do_movr,
+        [OP_JMPL] = &&do_jmpl,
+        [OP_JMPR] = &&do_jmpr,
+        [OP_SCAN] = &&do_scan,
+        [OP_PRNT] = &&do_prnt,
+        [OP_SETC] = &&do_setc,
+        [OP_MULA] = &&do_mula,
+        [OP_SKPR] = &&do_skpr,
+        [OP_SKPL] = &&do_skpl,
+        [OP_HALT] = &&do_halt
+    };
+
+    if (bf == NULL) {
+        atomic_store_explicit(&handlers, labels, memory_order_release);
+        return index;
+    }
+
+    const INS *bytecode = bf->program->bytecode;
+    byte *arr = bf->arr;
+    const INS *ip = bytecode;
+    bool sampling = bf->sample_rate > 0;
+
+    #define DISPATCH() goto *ip->handler
+    #define NEXT() { ip++; DISPATCH(); }
+
+    DISPATCH();
+
+    do_addn:
+        arr[index + ip->off] += ip->val;
+        NEXT();
+    do_subn:
+        arr[index + ip->off] -= ip->val;
+        NEXT();
+    do_movl:
+        index -= ip->val;
+        NEXT();
+    do_movr:
+        index += ip->val;
+        NEXT();
+    do_jmpl:
+        if (sampling) bf->at = ip - bytecode;
+        if (arr[index] == 0) ip = bytecode + ip->val;
+        NEXT();
+    do_jmpr:
+        if (sampling) bf->at = ip - bytecode;
+        if (--bf->fuel == 0 && budget_spent(bf)) budget_stop(bf, ip - bytecode);
+        ip = bytecode + ip->val;
+        DISPATCH();
+    do_scan:
+        in_get(bf, &arr[index + ip->off], ip->val);
+        NEXT();
+    do_prnt:
+        out_put(bf, arr[index + ip->off], ip->val);
+        NEXT();
+    do_setc:
+        arr[index + ip->off] = ip->val;
+        NEXT();
+    do_mula:
+        if (arr[index] != 0) arr[index + ip->off] += arr[index] * ip->val;
+        NEXT();
+    do_skpr:
+        index = scan_right(bf, index, ip->val);
+        NEXT();
+    do_skpl:
+        index = scan_left(bf, index, ip->val);
+        NEXT();
+    do_halt:
+        return index;
+
+    #undef NEXT
+    #undef DISPATCH
+#else
+    FAIL(1, "Error: threaded engine needs computed goto (GCC or Clang).\n");
+#endif
+}
+
+// executes the bytecode packed by make_packed, decoding operands as it goes
+static long long run_packed(BF *bf, long long index)
+{
+    code_make(bf);
+
+    byte *code = bf->packed;
+    byte *arr = bf->arr;
+    const byte *pc = code;
+    bool sampling = bf->sample_rate > 0;
+
+    // reads a varint at pc into v and moves past it
+    #define VARINT(v) for (int shift = (v = 0); ; shift += 7) { v |= (long long) (*pc & 127) << shift; if (*pc++ < 128) break; }
+
+    for (;;)
+    {
+        byte op = *pc++;
+        long long off = 0, val;
+        uint32_t target;
+
+        if (op & PACK_OFF)
+        {
+            VARINT(off);
+            off = (off >> 1) ^ -(off & 1);
+        }
+
+        switch (op & PACK_OP)
+        {
+            case OP_ADDN:
+                VARINT(val);
+                arr[index + off] += val;
+                break;
+            case OP_SUBN:
+                VARINT(val);
+                arr[index + off] -= val;
+                break;
+            case OP_MOVL:
+                VARINT(val);
+                index -= val;
+                break;
+            case OP_MOVR:
+                VARINT(val);
+                index += val;
+                break;
+            case OP_JMPL:
+                if (sampling) bf->at = pc - 1 - code;
+                memcpy(&target, pc, 4);
+                pc = (arr[index] == 0) ? code + target : pc + 4;
+                break;
+            case OP_JMPR:
+                if (sampling) bf->at = pc - 1 - code;
+                if (--bf->fuel == 0 && budget_spent(bf)) budget_stop(bf, pack_index(code, pc - 1));
+                memcpy(&target, pc, 4);
+                pc = (arr[index] != 0) ? code + target : pc + 4;
+                break;
+            case OP_SCAN:
+                VARINT(val);
+                in_get(bf, &arr[index + off], val);
+                break;
+            case OP_PRNT:
+                VARINT(val);
+                out_put(bf, arr[index + off], val);
+                break;
+            case OP_SETC:
+                VARINT(val);
+                arr[index + off] = val;
+                break;
+            case OP_MULA:
+                VARINT(val);
+                if (arr[index] != 0) arr[index + off] += arr[index] * val;
+                break;
+            case OP_SKPR:
+                VARINT(val);
+                index = scan_right(bf, index, val);
+                break;
+            case OP_SKPL:
+                VARINT(val);
+                index = scan_left(bf, index, val);
+                break;
+            default:
+                return index;
+        }
+    }
+
+    #undef VARINT
+}
+
+/*
+ * lays the bytecode out packed (see PACK_OP). sizes don't depend on where anything lands,
+ * so the first pass finds every instruction's position and the buffer is allocated exactly.
+ * the positions stay in bf->packed_at for sample_tick.
+ * [ jumps past its ], and ] back past its [ while the cell isn't 0.
+ */
+static byte *make_packed(BF *bf, long long *packed_length)
+{
+    const INS *bytecode = bf->program->bytecode;
+    long long bytecode_length = bf->program->length;
+
+    long long *at = malloc(sizeof(long long) * (bytecode_length + 2));
+    FAIL_IF(at == NULL, 2, "Error: unable to allocate memory.\n");
+
+    at[0] = 0;
+    for (long long i = 0; i <= bytecode_length; i++) at[i + 1] = at[i] + pack_size(&bytecode[i]);
+
+    *packed_length = at[bytecode_length + 1];
+    FAIL_IF(*packed_length > UINT32_MAX, 2, "Error: program too large to pack.\n");
+
+    byte *code = malloc(*packed_length);
+    FAIL_IF(code == NULL, 2, "Error: unable to allocate memory.\n");
+
+    byte *pc = code;
+
+    for (long long i = 0; i <= bytecode_length; i++)
+    {
+        const INS *ins = &bytecode[i];
+
+        *pc++ = ins->OP_type | ((ins->off != 0) ? PACK_OFF : 0);
+        if (ins->off != 0) pc = pack_varint(pc, ((unsigned long long) ins->off << 1) ^ (ins->off >> 31));
+
+        if (ins->OP_type == OP_JMPL || ins->OP_type == OP_JMPR)
+        {
+            uint32_t target = at[ins->val + 1];
+            memcpy(pc, &target, 4);
+            pc += 4;
+        }
+        else if (ins->OP_type != OP_HALT) pc = pack_varint(pc, ins->val);
+    }
+
+    bf->packed_at = at;
+    return code;
+}
+
+// bytes `ins` takes once packed
+static long long pack_size(const INS *ins)
+{
+    byte scratch[10];
+    long long size = 1;
+
+    if (ins->off != 0) size += pack_varint(scratch, ((unsigned long long) ins->off << 1) ^ (ins->off >> 31)) - scratch;
+
+    if (ins->OP_type == OP_JMPL || ins->OP_type == OP_JMPR) size += 4;
+    else if (ins->OP_type != OP_HALT) size += pack_varint(scratch, ins->val) - scratch;
+
+    return size;
+}
+
+// which instruction of the bytecode the packed one at `at` is, only needed to say where a run stopped
+static long long pack_index(const byte *code, const byte *at)
+{
+    long long index = 0;
+
+    for (const byte *pc = code; pc < at; index++)
+    {
+        byte op = *pc++;
+
+        if (op & PACK_OFF) while (*pc++ >= 128);
+
+        if ((op & PACK_OP) == OP_JMPL || (op & PACK_OP) == OP_JMPR) pc += 4;
+        else while (*pc++ >= 128);
+    }
+
+    return index;
+}
+
+// writes value 7 bits at a time, lowest first, and returns where it ended
+static byte *pack_varint(byte *at, unsigned long long value)
+{
+    for (; value >= 128; value >>= 7) *at++ = (value & 127) | 128;
+    *at++ = value;
+    return at;
+}
+
+/*
+ * x86-64 jit: the tape pointer (arr + index) lives in rbx, every op becomes a few native
+ * instructions addressing [rbx + off], and loops become cmp/jcc pairs. I/O and scans call
+ * back into C. compiled code takes the tape pointer and returns where it ended up.
+ */
+static long long run_jit(BF *bf, long long index)
+{
+#if defined(__x86_64__) && !defined(_WIN32)
+    code_make(bf);
+
+    byte *(*code)(byte *) = (byte *(*)(byte *)) bf->jit.code;
+    return code(bf->arr + index) - bf->arr;
+#else
+    FAIL(1, "Error: the jit engine needs x86-64.\n");
+#endif
+}
+
+/*
+ * tiered: runs like run_switch but counts the back-edges of every loop. once a loop
+ * takes `tier_threshold` of them it is queued for the jit on a background thread, and
+ * the next time the interpreter reaches its [ with the code ready it calls that instead.
+ */
+static long long run_tiered(BF *bf, long long index)
+{
+#if defined(__x86_64__) && !defined(_WIN32)
+    const INS *bytecode = bf->program->bytecode;
+    long long bytecode_length = bf->program->length;
+    byte *arr = bf->arr;
+
+    bool sampling = bf->sample_rate > 0;
+
+    TIERING *tiering = &bf->tiering;
+    tier_start(bf);
+
+    for (long long i = 0; i < bytecode_length; i++)
+    {
+        switch(bytecode[i].OP_type)
+        {
+            case OP_ADDN:
+                arr[index + bytecode[i].off] += bytecode[i].val;
+                break;
+            case OP_SUBN:
+                arr[index + bytecode[i].off] -= bytecode[i].val;
+                break;
+            case OP_MOVL:
+                index -= bytecode[i].val;
+                break;
+            case OP_MOVR:
+                index += bytecode[i].val;
+                break;
+            case OP_JMPL:
+                if (sampling) bf->at = i; // samples in compiled loops go to the loop
+                if (atomic_load_explicit(&tiering->loops[i].state, memory_order_acquire) == TIER_READY) {
+                    byte *(*code)(byte *) = (byte *(*)(byte *)) tiering->loops[i].jit.code;
+                    index = code(arr + index) - arr;
+                    i = bytecode[i].val;
+                }
+                else if (arr[index] == 0) i = bytecode[i].val;
+                break;
+            case OP_JMPR:
+                if (sampling) bf->at = i;
+                if (--bf->fuel == 0 && budget_spent(bf)) budget_stop(bf, i);
+                if (++tiering->loops[bytecode[i].val].hits == bf->tier_threshold) tier_queue(bf, bytecode[i].val);
+                i = bytecode[i].val - 1; // subtract 1 because of i++
+                break;
+            case OP_SCAN:
+                in_get(bf, &arr[index + bytecode[i].off], bytecode[i].val);
+                break;
+            case OP_PRNT:
+                out_put(bf, arr[index + bytecode[i].off], bytecode[i].val);
+                break;
+            case OP_SETC:
+                arr[index + bytecode[i].off] = bytecode[i].val;
+                break;
+            case OP_MULA:
+                if (arr[index] != 0) arr[index + bytecode[i].off] += arr[index] * bytecode[i].val;
+                break;
+            case OP_SKPR:
+                index = scan_right(bf, index, bytecode[i].val);
+                break;
+            case OP_SKPL:
+                index = scan_left(bf, index, bytecode[i].val);
+                break;
+        }
+    }
+
+    tier_stop(bf);
+    return index;
+#else
+    FAIL(1, "Error: the tiered engine needs x86-64.\n");
+#endif
+}
+
+#if defined(__x86_64__) && !defined(_WIN32)
+
+static void tier_start(BF *bf)
+{
+    TIERING *tiering = &bf->tiering;
+
+    tiering->loops = calloc(bf->program->length, sizeof(TIER));
+    tiering->queue = malloc(sizeof(long long) * bf->program->length);
+    FAIL_IF(tiering->loops == NULL || tiering->queue == NULL, 2, "Error: unable to allocate memory.\n");
+
+    tiering->queued = tiering->compiled = 0;
+    tiering->done = false;
+
+    // the compiler thread starts with SIGPROF blocked, so --sample's ticks land on the thread
+    // running the program and not on one where bf_current is NULL
+    sigset_t blocked, mask;
+    sigemptyset(&blocked);
+    sigaddset(&blocked, SIGPROF);
+    pthread_sigmask(SIG_BLOCK, &blocked, &mask);
+
+    int failed = pthread_create(&tiering->thread, NULL, tier_worker, bf);
+    pthread_sigmask(SIG_SETMASK, &mask, NULL);
+    FAIL_IF(failed != 0, 2, "Error: unable to start the jit thread.\n");
+}
+
+// waits for the compiler thread and unmaps everything it made
+static void tier_stop(BF *bf)
+{
+    TIERING *tiering = &bf->tiering;
+
+    pthread_mutex_lock(&tiering->lock);
+    tiering->done = true;
+    pthread_cond_signal(&tiering->wake);
+    pthread_mutex_unlock(&tiering->lock);
+
+    pthread_join(tiering->thread, NULL);
+
+    for (long long i = 0; i < bf->program->length; i++)
+        if (tiering->loops[i].state == TIER_READY)
+        {
+            munmap(tiering->loops[i].jit.code, tiering->loops[i].jit.capacity);
+            free(tiering->loops[i].jit.starts);
+        }
+
+    free(tiering->loops);
+    free(tiering->queue);
+    tiering->loops = NULL;
+    tiering->queue = NULL;
+}
+
+// hands the loop starting at bytecode[start] to the compiler thread
+static void tier_queue(BF *bf, long long start)
+{
+    TIERING *tiering = &bf->tiering;
+
+    pthread_mutex_lock(&tiering->lock);
+    tiering->loops[start].state = TIER_QUEUED;
+    tiering->queue[tiering->queued++] = start;
+    pthread_cond_signal(&tiering->wake);
+    pthread_mutex_unlock(&tiering->lock);
+}
+
+static void *tier_worker(void *context)
+{
+    BF *bf = context;
+    TIERING *tiering = &bf->tiering;
+
+    pthread_mutex_lock(&tiering->lock);
+
+    while (true)
+    {
+        while (!tiering->done && tiering->compiled == tiering->queued) pthread_cond_wait(&tiering->wake, &tiering->lock);
+        if (tiering->done) break;
+
+        long long start = tiering->queue[tiering->compiled++];
+        pthread_mutex_unlock(&tiering->lock);
+
+        // the bytecode is never written while it runs, so compiling next to the interpreter is safe
+        tiering->loops[start].jit = jit_compile(bf, start, bf->program->bytecode[start].val + 1);
+        atomic_store_explicit(&tiering->loops[start].state, TIER_READY, memory_order_release);
+
+        pthread_mutex_lock(&tiering->lock);
+    }
+
+    pthread_mutex_unlock(&tiering->lock);
+    return NULL;
+}
+
+#endif
+
+#if defined(__x86_64__) && !defined(_WIN32)
+
+// compiles bytecode[start, end) into a function, loops in the range have to be whole
+static JIT jit_compile(BF *bf, long long start, long long end)
+{
+    // no op needs more than JIT_INS_SIZE bytes, the prologue and epilogue fit in one more
+    JIT jit = {NULL, 0, JIT_INS_SIZE * (end - start + 1), NULL};
+
+    jit.code = mmap(NULL, jit.capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    FAIL_IF(jit.code == MAP_FAILED, 2, "Error: unable to allocate memory.\n");
+
+    // where each instruction starts in jit.code, to patch loop jumps, kept for sample_tick
+    long long *starts = jit.starts = malloc(sizeof(long long) * (end - start + 1));
+    FAIL_IF(starts == NULL, 2, "Error: unable to allocate memory.\n");
+
+    // only runs with a budget pay for counting loop passes
+    bool budget = bf->max_steps > 0 || bf->timeout > 0;
+    long long group = -1; // the je to patch past the MULAs being compiled
+
+    EMIT(&jit, 0x53);             // push rbx
+    EMIT(&jit, 0x48, 0x89, 0xFB); // mov rbx, rdi
+
+    for (long long i = start; i < end; i++)
+    {
+        const INS *ins = &bf->program->bytecode[i];
+        long long loop;
+        bool grouped = i + 1 < end && ins[1].OP_type == OP_MULA;
+
+        starts[i - start] = jit.length;
+
+        switch (ins->OP_type)
+        {
+            case OP_ADDN:
+            case OP_SUBN:
+                EMIT(&jit, 0x80, 0x83);   // add byte [rbx + off], val
+                emit_imm32(&jit, ins->off);
+                EMIT(&jit, (ins->OP_type == OP_ADDN) ? ins->val : -ins->val);
+                break;
+            case OP_SETC:
+                EMIT(&jit, 0xC6, 0x83);   // mov byte [rbx + off], val
+                emit_imm32(&jit, ins->off);
+                EMIT(&jit, ins->val);
+                break;
+            case OP_MOVL:
+            case OP_MOVR:
+                EMIT(&jit, 0x48, 0xB8);   // mov rax, val
+                emit_imm64(&jit, (ins->OP_type == OP_MOVR) ? ins->val : -ins->val);
+                EMIT(&jit, 0x48, 0x01, 0xC3); // add rbx, rax
+                break;
+            case OP_MULA:
+                // one test for the MULAs of a loop, they are skipped when its cell is 0
+                if (group == -1)
+                {
+                    EMIT(&jit, 0x80, 0x3B, 0x00); // cmp byte [rbx], 0
+                    EMIT(&jit, 0x0F, 0x84);   // je past the last of them, patched there
+                    group = jit.length;
+                    emit_imm32(&jit, 0);
+                }
+                EMIT(&jit, 0x0F, 0xB6, 0x03); // movzx eax, byte [rbx]
+                EMIT(&jit, 0x69, 0xC0);   // imul eax, eax, val
+                emit_imm32(&jit, ins->val);
+                EMIT(&jit, 0x00, 0x83);   // add byte [rbx + off], al
+                emit_imm32(&jit, ins->off);
+
+                if (!grouped)
+                {
+                    jit_patch(&jit, group, jit.length - (group + 4));
+                    group = -1;
+                }
+                break;
+            case OP_JMPL:
+                EMIT(&jit, 0x80, 0x3B, 0x00); // cmp byte [rbx], 0
+                EMIT(&jit, 0x0F, 0x84);   // je past the matching ], patched there
+                emit_imm32(&jit, 0);
+                break;
+            case OP_JMPR:
+                loop = ins->val - start;
+                if (budget)
+                {
+                    EMIT(&jit, 0x48, 0xB8);   // mov rax, &bf->fuel
+                    emit_imm64(&jit, (int64_t) &bf->fuel);
+                    EMIT(&jit, 0x48, 0xFF, 0x08); // dec qword [rax]
+                    EMIT(&jit, 0x75, 22);     // jnz past the call
+                    EMIT(&jit, 0x48, 0xBF);   // mov rdi, i
+                    emit_imm64(&jit, i);
+                    emit_call(&jit, (void *) jit_budget);
+                }
+                EMIT(&jit, 0x80, 0x3B, 0x00); // cmp byte [rbx], 0
+                EMIT(&jit, 0x0F, 0x85);   // jne right after the matching [
+                emit_imm32(&jit, (starts[loop] + JIT_JMPL_SIZE) - (jit.length + 4));
+
+                jit_patch(&jit, starts[loop] + JIT_JMPL_SIZE - 4, jit.length - (starts[loop] + JIT_JMPL_SIZE));
+                break;
+            case OP_SCAN:
+            case OP_PRNT:
+                EMIT(&jit, 0x48, 0x8D, 0xBB); // lea rdi, [rbx + off]
+                emit_imm32(&jit, ins->off);
+                EMIT(&jit, 0x48, 0xBE);   // mov rsi, val
+                emit_imm64(&jit, ins->val);
+                emit_call(&jit, (ins->OP_type == OP_SCAN) ? (void *) jit_read : (void *) jit_print);
+                break;
+            case OP_SKPR:
+            case OP_SKPL:
+                // most scans start on a 0, those never leave the code
+                EMIT(&jit, 0x80, 0x3B, 0x00); // cmp byte [rbx], 0
+                EMIT(&jit, 0x74, 28);     // je past the call
+                EMIT(&jit, 0x48, 0x89, 0xDF); // mov rdi, rbx
+                EMIT(&jit, 0x48, 0xBE);   // mov rsi, val
+                emit_imm64(&jit, ins->val);
+                emit_call(&jit, (ins->OP_type == OP_SKPR) ? (void *) jit_scan_right : (void *) jit_scan_left);
+                EMIT(&jit, 0x48, 0x89, 0xC3); // mov rbx, rax
+                break;
+        }
+    }
+
+    EMIT(&jit, 0x48, 0x89, 0xD8); // mov rax, rbx
+    EMIT(&jit, 0x5B);             // pop rbx
+    EMIT(&jit, 0xC3);             // ret
+
+    FAIL_IF(mprotect(jit.code, jit.capacity, PROT_READ | PROT_EXEC) != 0, 2, "Error: unable to map jit code.\n");
+    return jit;
+}
+
+static void emit_bytes(JIT *jit, const byte *bytes, size_t count)
+{
+    memcpy(jit->code + jit->length, bytes, count);
+    jit->length += count;
+}
+
+static void emit_imm32(JIT *jit, int32_t imm)
+{
+    emit_bytes(jit, (const byte *) &imm, 4);
+}
+
+static void emit_imm64(JIT *jit, int64_t imm)
+{
+    emit_bytes(jit, (const byte *) &imm, 8);
+}
+
+// mov rax, fn; call rax. rbx is callee-saved so the tape pointer survives the call
+static void emit_call(JIT *jit, void *fn)
+{
+    EMIT(jit, 0x48, 0xB8);
+    emit_imm64(jit, (int64_t) fn);
+    EMIT(jit, 0xFF, 0xD0);
+}
+
+static void jit_patch(JIT *jit, size_t at, int32_t imm)
+{
+    memcpy(jit->code + at, &imm, 4);
+}
+
+#endif
+
+static void jit_print(byte *cell, long long count)
+{
+    out_put(bf_current, *cell, count);
+}
+
+static void jit_read(byte *cell, long long count)
+{
+    in_get(bf_current, cell, count);
+}
+
+static void jit_budget(long long at)
+{
+    if (budget_spent(bf_current)) budget_stop(bf_current, at);
+}
+
+/*
+ * appends `count` copies of c to the output. a run too long for the buffer goes out
+ * with what is buffered in one writev, in chunks of a buffer's size.
+ */
+static void out_put(BF *bf, byte c, long long count)
+{
+    OUTPUT *out = &bf->out;
+
+    long long room = sizeof(out->data) - out->length;
+
+    if (count >= room && count < (long long) sizeof(out->data))
+    {
+        out_flush(bf);
+        room = sizeof(out->data);
+    }
+
+    if (count < room)
+    {
+        if (count == 1) out->data[out->length++] = c;
+        else 
+        {
+            memset(out->data + out->length, c, count);
+            out->length += count;
+        }
+
+        if (c == '\n' && out->policy == FLUSH_LINE) out_flush(bf);
+        return;
+    }
+
+    byte run[sizeof(out->data)];
+    memset(run, c, sizeof(run));
+
+    while (count > 0)
+    {
+        struct iovec iov[OUT_IOV];
+        int chunks = 0;
+
+        if (out->length > 0) iov[chunks++] = (struct iovec) {out->data, out->length};
+
+        for (; chunks < OUT_IOV && count > 0; chunks++)
+        {
+            long long length = min(count, (long long) sizeof(run));
+            iov[chunks] = (struct iovec) {run, length};
+            count -= length;
+        }
+
+        out_drain(bf, iov, chunks);
+        out->length = 0;
+    }
+}
+
+static void out_flush(BF *bf)
+{
+    OUTPUT *out = &bf->out;
+
+    if (out->length == 0) return;
+
+    struct iovec iov = {out->data, out->length};
+    out_drain(bf, &iov, 1);
+    out->length = 0;
+}
+
+// writes all of `iov`, picking up after short writes
+static void out_drain(BF *bf, struct iovec *iov, int count)
+{
+    OUTPUT *out = &bf->out;
+
+    if (out->sink != NULL)
+    {
+        // whatever doesn't fit the caller's buffer is dropped, and the run says so
+        for (int i = 0; i < count; i++)
+        {
+            size_t length = min(iov[i].iov_len, out->sink_capacity - out->sink_length);
+            memcpy(out->sink + out->sink_length, iov[i].iov_base, length);
+            out->sink_length += length;
+
+            if (length < iov[i].iov_len && bf->status == BF_OK) bf->status = BF_OUTPUT_FULL;
+        }
+        return;
+    }
+
+    if (out->write != NULL)
+    {
+        // a run that stopped early still hands over what it printed before it stopped
+        for (int i = 0; i < count && bf->status != BF_OUTPUT_CLOSED; i++)
+            if (!out->write(out->write_context, iov[i].iov_base, iov[i].iov_len)) bf->status = BF_OUTPUT_CLOSED;
+        return;
+    }
+
+    // prompts and errors go through stdio, keep them in order with the program's output
+    if (out->fd == STDOUT_FILENO) fflush(stdout);
+
+    while (count > 0)
+    {
+        ssize_t written = writev(out->fd, iov, min(count, OUT_IOV));
+
+        if (written < 0)
+        {
+            if (errno == EINTR) continue;
+            return; // nowhere to print it, drop it like stdio would
+        }
+
+        for (; count > 0 && (size_t) written >= iov->iov_len; iov++, count--) 
+            written -= iov->iov_len;
+
+        if (count > 0)
+        {
+            iov->iov_base = (byte *) iov->iov_base + written;
+            iov->iov_len -= written;
+        }
+    }
+}
+
+// reads `count` bytes into the cell, the last one stays
+static void in_get(BF *bf, byte *cell, long long count)
+{
+    INPUT *in = &bf->in;
+
+    // don't leave a prompt sitting in the buffer while we wait on the user
+    if (bf->out.policy == FLUSH_READ || bf->out.interactive) out_flush(bf);
+
+    while (count > 0)
+    {
+        if (in->pos == in->length && !in_refill(bf))
+        {
+            in->eof(cell);
+            return;
+        }
+
+        long long taken = min(count, in->length - in->pos);
+        in->pos += taken;
+        count -= taken;
+        *cell = in->data[in->pos - 1];
+    }
+}
+
+static void in_init(BF *bf)
+{
+    INPUT *in = &bf->in;
+
+    struct stat info;
+
+    in->data = in->buffer;
+    in->length = in->pos = 0;
+    in->ready = true;
+    in->fixed = false;
+    bf->out.interactive = isatty(in->fd);
+    if (in->stdio || fstat(in->fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0) return;
+
+    // map from 0 since the offset has to be page aligned, and start where stdin is at
+    off_t at = lseek(in->fd, 0, SEEK_CUR);
+    void *data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, in->fd, 0);
+    if (at < 0 || data == MAP_FAILED) return;
+
+    madvise(data, info.st_size, MADV_SEQUENTIAL);
+    in->data = data;
+    in->length = info.st_size;
+    in->pos = min(at, info.st_size);
+    in->fixed = in->mapped = true;
+}
+
+// only called once `in` is used up, returns false at the end of the input
+static bool in_refill(BF *bf)
+{
+    INPUT *in = &bf->in;
+
+    if (in->fixed) return false;
+
+    if (in->stdio)
+    {
+        int c = getchar();
+        if (c == EOF) return false;
+
+        in->buffer[0] = c;
+        in->length = 1;
+        in->pos = 0;
+        return true;
+    }
+
+    ssize_t got;
+    in->data = in->buffer;
+    do got = read(in->fd, in->buffer, sizeof(in->buffer));
+    while (got < 0 && errno == EINTR);
+
+    if (got <= 0) return false;
+
+    in->length = got;
+    in->pos = 0;
+    return true;
+}
+
+static void in_eof_unchanged(byte *cell) { (void) cell; }
+
+static void in_eof_zero(byte *cell)
+{
+    *cell = 0;
+}
+
+static void in_eof_max(byte *cell)
+{
+    *cell = 255;
+}
+
+static byte *jit_scan_right(byte *cell, long long stride)
+{
+    return bf_current->arr + scan_right(bf_current, cell - bf_current->arr, stride);
+}
+
+static byte *jit_scan_left(byte *cell, long long stride)
+{
+    return bf_current->arr + scan_left(bf_current, cell - bf_current->arr, stride);
+}
+
+/*
+ * the tape is reserved up to its limit with PROT_NONE and committed as the program walks
+ * into it: touching an uncommitted cell faults and tape_fault maps more, so no op has to
+ * check bounds. guard regions on both ends turn running off the tape into an error.
+ */
+static void tape_init(BF *bf)
+{
+    TAPE *tape = &bf->tape;
+    long long page = sysconf(_SC_PAGESIZE);
+
+    tape->page = page;
+    tape->limit = (bf->tape_limit + page - 1) / page * page;
+    tape->size = 2 * TAPE_GUARD + tape->limit; // guard, cells, guard
+    tape->committed = min(TAPE_CHUNK, tape->limit);
+
+    tape->base = mmap(NULL, tape->size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    FAIL_IF(tape->base == MAP_FAILED, 2, "Error: unable to reserve the tape.\n");
+
+    bf->arr = tape->base + TAPE_GUARD;
+    FAIL_IF(mprotect(bf->arr, tape->committed, PROT_READ | PROT_WRITE) != 0, 2, "Error: unable to map the tape.\n");
+}
+
+// a blank tape for the next run: dropped pages read back as 0, so a big tape costs nothing to reset
+static void tape_reset(BF *bf)
+{
+    TAPE *tape = &bf->tape;
+
+    if (tape->base != NULL) madvise(bf->arr, tape->committed, MADV_DONTNEED);
+    bf->index = 0;
+}
+
+// installs tape_fault once per process and gives this thread a stack for it
+static void fault_init(void)
+{
+    static _Thread_local bool ready = false;
+    if (ready) return;
+
+    // the handler gets its own stack so it still runs if the fault came from a full one
+    stack_t stack = {.ss_sp = malloc(SIGSTKSZ), .ss_size = SIGSTKSZ, .ss_flags = 0};
+    FAIL_IF(stack.ss_sp == NULL || sigaltstack(&stack, NULL) != 0, 2, "Error: unable to set up the signal stack.\n");
+
+    struct sigaction action = {0};
+    action.sa_sigaction = tape_fault;
+    action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGSEGV, &action, NULL);
+
+    ready = true;
+}
+
+/*
+ * arms SIGPROF for the run, clearing the samples if they are of another program. the
+ * timer is the process's, so one context at a time can sample.
+ */
+static void sample_start(BF *bf)
+{
+    if (bf->sampled != bf->program->serial)
+    {
+        free(bf->hits);
+        bf->hits = calloc(bf->program->length + 2, sizeof(long long));
+        FAIL_IF(bf->hits == NULL, 2, "Error: unable to allocate memory.\n");
+        bf->sampled = bf->program->serial;
+    }
+
+    // installed on every start rather than once, so no thread can arm the timer before
+    // the handler is in place
+    struct sigaction action = {0};
+    action.sa_sigaction = sample_tick;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGPROF, &action, NULL);
+
+    long long interval = max(1000000 / bf->sample_rate, 1);
+    struct itimerval timer = {{interval / 1000000, interval % 1000000}, {interval / 1000000, interval % 1000000}};
+    setitimer(ITIMER_PROF, &timer, NULL);
+}
+
+static void sample_stop(BF *bf)
+{
+    (void) bf;
+    struct itimerval timer = {{0, 0}, {0, 0}};
+    setitimer(ITIMER_PROF, &timer, NULL);
+}
+
+// counts a sample for the instruction engine_at finds, hits[0] and hits[1] being its -2 and -1
+static void sample_tick(int sig, siginfo_t *info, void *context)
+{
+    (void) sig, (void) info;
+    BF *bf = bf_current;
+    if (bf == NULL || bf->program == NULL || bf->hits == NULL) return;
+
+    long long at = engine_at(bf, context);
+    if (at >= -2 && at < bf->program->length) bf->hits[at + 2]++;
+}
+
+/*
+ * the instruction the run interrupted by a signal is at, from its `context`: the [ or ]
+ * an interpreter last went through, -1 before the first, or for jit code the instruction
+ * holding the interrupted address, -2 outside the code and its helpers.
+ */
+static long long engine_at(BF *bf, void *context)
+{
+    long long at = bf->at;
+    long long length = bf->program->length;
+
+    if (bf->engine == ENGINE_PACKED && !bf->profile && at >= 0) at = sample_find(bf->packed_at, length + 1, at);
+
+#if defined(__x86_64__) && defined(__linux__)
+    if (bf->engine == ENGINE_JIT && !bf->profile && bf->jit.code != NULL)
+    {
+        byte *code = bf->jit.code, *end = code + bf->jit.length;
+        byte *pc = (byte *) ((ucontext_t *) context)->uc_mcontext.gregs[REG_RIP];
+        byte **stack = (byte **) ((ucontext_t *) context)->uc_mcontext.gregs[REG_RSP];
+
+        // in a helper the code called (a scan, , or .), the nearest return address into
+        // the code says which. the helpers are small, so it is near the top of the stack
+        for (int i = 0; i < 16 && (pc < code || pc >= end); i++) pc = stack[i] - 1;
+
+        at = (pc >= code && pc < end) ? sample_find(bf->jit.starts, length, pc - code) : -2;
+    }
+#endif
+
+    return at;
+}
+
+// the last of `count` ascending starts at or before `offset`, so empty instructions lose to the next
+static long long sample_find(const long long *starts, long long count, long long offset)
+{
+    long long low = 0, high = count - 1;
+
+    while (low < high)
+    {
+        long long middle = (low + high + 1) / 2;
+        if (starts[middle] <= offset) low = middle;
+        else high = middle - 1;
+    }
+
+    return low;
+}
+
+static void tape_fault(int sig, siginfo_t *info, void *context)
+{
+    byte *addr = info->si_addr;
+    BF *bf = bf_current;
+
+    if (bf == NULL)
+    {
+        signal(sig, SIG_DFL);
+        return;
+    }
+
+    TAPE *tape = &bf->tape;
+    byte *arr = bf->arr;
+
+    if (addr >= arr + tape->committed && addr < arr + tape->limit)
+    {
+        // at least double, so a long walk right costs a logarithmic number of faults
+        long long want = max(2 * tape->committed, addr - arr + 1);
+        want = min((want + tape->page - 1) / tape->page * tape->page, tape->limit);
+
+        if (mprotect(arr + tape->committed, want - tape->committed, PROT_READ | PROT_WRITE) == 0)
+        {
+            tape->committed = want;
+            return;
+        }
+    }
+
+    // ran off the tape, bf_run picks up from here and reports it
+    if (addr >= tape->base && addr < tape->base + tape->size)
+    {
+        // only jit code knows the instruction that faulted, an interpreter only the ] it last
+        // went through, which would point at the wrong place
+        bf->status = BF_TAPE_ERROR;
+        bf->stopped_at = (bf->engine == ENGINE_JIT && !bf->profile) ? max(engine_at(bf, context), -1) : -1;
+        siglongjmp(bf->stop, 1);
+    }
+
+    // not a tape access, crash like we normally would
+    signal(sig, SIG_DFL);
+}
+
+/*
+ * the scans look at the first SCAN_SHORT cells one by one, most stop there. past that they
+ * look at 64 cells per step: `lanes` marks the cells a step can stop on, a multiple of
+ * stride apart, and the window then moves by that many strides.
+ * a unit stride is plain memchr or memrchr, which are quick from the first cell.
+ */
+static long long scan_right(BF *bf, long long index, long long stride)
+{
+    byte *arr = bf->arr;
+
+    // search what is committed, then touch the next cell: that grows the tape or ends the run
+    if (stride == 1)
+    {
+        while (arr[index] != 0)
+        {
+            byte *zero = memchr(arr + index, 0, bf->tape.committed - index);
+            if (zero != NULL) return zero - arr;
+            index = bf->tape.committed;
+        }
+
+        return index;
+    }
+
+    for (int k = 0; k < SCAN_SHORT; k++, index += stride)
+        if (arr[index] == 0) return index;
+
+    unsigned long long lanes = 0;
+    int window = 0;
+
+    while (arr[index] != 0)
+    {
+#ifdef __GNUC__
+        if (lanes == 0) for (window = 0; window < 64; window += stride) lanes |= 1ull << window;
+
+        for (; stride < 64 && index + 64 <= bf->tape.committed; index += window)
+        {
+            unsigned long long hits = zero_mask(arr + index) & lanes;
+            if (hits) return index + __builtin_ctzll(hits);
+        }
+#endif
+
+        while (index < bf->tape.committed && arr[index] != 0) index += stride;
+        if (index < bf->tape.committed) return index;
+    }
+
+    return index;
+}
+
+static long long scan_left(BF *bf, long long index, long long stride)
+{
+    byte *arr = bf->arr;
+
+#ifdef _GNU_SOURCE
+    if (stride == 1)
+    {
+        if (arr[index] == 0) return index;
+
+        byte *zero = memrchr(arr, 0, index);
+        if (zero != NULL) return zero - arr;
+        index = -1;
+    }
+#endif
+
+    // past cell 0 these fault in the guard page
+    for (int k = 0; k < SCAN_SHORT; k++, index -= stride)
+        if (arr[index] == 0) return index;
+
+#ifdef __GNUC__
+    if (stride < 64 && index >= 63) {
+        unsigned long long lanes = 0;
+        long long window;
+
+        for (window = 0; window < 64; window += stride) lanes |= 1ull << (63 - window);
+
+        for (; index >= 63; index -= window)
+        {
+            unsigned long long hits = zero_mask(arr + index - 63) & lanes;
+            if (hits) return index - __builtin_clzll(hits);
+        }
+    }
+#endif
+
+    while (arr[index] != 0) index -= stride;
+
+    return index;
+}
+
+// bit k is set when cells[k] == 0, for the 64 cells starting at cells
+static unsigned long long zero_mask(const byte *cells)
+{
+#if defined(__AVX2__)
+    __m256i zero = _mm256_setzero_si256();
+    unsigned long long low  = (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *) cells), zero));
+    unsigned long long high = (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *) (cells + 32)), zero));
+
+    return low | high << 32;
+#elif defined(__SSE2__)
+    __m128i zero = _mm_setzero_si128();
+    unsigned long long mask = 0;
+
+    for (int k = 0; k < 4; k++)
+        mask |= (unsigned long long) (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (cells + 16 * k)), zero)) << (16 * k);
+
+    return mask;
+#else
+    unsigned long long mask = 0;
+
+    for (int k = 0; k < 64; k++) mask |= (unsigned long long) (cells[k] == 0) << k;
+
+    return mask;
+#endif
+}
+
+/*
+ * FNV-1a over the source, the passes that are on, CACHE_VERSION and the shape of the
+ * bytecode (how many ops there are and how big an INS is), so any of them changing misses.
+ */
+static uint64_t cache_key(BF *bf, const char *line, long long length)
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    for (long long i = 0; i < length; i++) hash = (hash ^ (byte) line[i]) * 1099511628211ull;
+    for (int i = 0; i < PASS_COUNT; i++) hash = (hash ^ ((bf->passes >> i) & 1)) * 1099511628211ull;
+    hash = (hash ^ OP_HALT) * 1099511628211ull;
+    hash = (hash ^ sizeof(INS)) * 1099511628211ull;
+
+    return (hash ^ CACHE_VERSION) * 1099511628211ull;
+}
+
+static void cache_path(BF *bf, char *path, uint64_t key)
+{
+    snprintf(path, PATH_MAX, "%s/%016llx.bfc", bf->cache_dir, (unsigned long long) key);
+}
+
+/*
+ * maps the compiled program for `key` into `program` and returns its length, or -1 if there
+ * isn't a usable one. the mapping is private so handlers can be written into it.
+ */
+static long long cache_load(BF *bf, BF_PROGRAM *program, uint64_t key, long long length)
+{
+    char path[PATH_MAX];
+    cache_path(bf, path, key);
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+
+    struct stat info;
+    void *data = MAP_FAILED;
+
+    if (fstat(fd, &info) == 0 && info.st_size >= (off_t) (sizeof(CACHE_HEADER) + sizeof(INS)))
+        data = mmap(NULL, info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED) return -1;
+
+    CACHE_HEADER *header = data;
+    INS *code = (INS *) (header + 1);
+    long long code_length = header->length, line_count = header->lines;
+    int64_t *positions = (int64_t *) (code + code_length + 1), *lines = positions + code_length + 1;
+
+    bool valid = memcmp(header->magic, "BFC", 4) == 0 && header->version == CACHE_VERSION
+              && header->key == key && header->source == length && code_length >= 0 && line_count >= 1
+              && code_length < info.st_size && line_count < info.st_size
+              && info.st_size == (off_t) (sizeof(CACHE_HEADER) + (sizeof(INS) + sizeof(int64_t)) * (code_length + 1)
+                                          + sizeof(int64_t) * line_count)
+              && code[code_length].OP_type == OP_HALT;
+
+    // a damaged file must not send the engines off the end of the code, so every [ has to
+    // jump forward to the ] that jumps back to it, nested the way the compiler leaves them
+    long long depth = 0, *stack = valid ? malloc(sizeof(long long) * (code_length + 1)) : NULL;
+    FAIL_IF(valid && stack == NULL, 2, "Error: unable to allocate memory.\n");
+
+    for (long long i = 0; valid && i < code_length; i++)
+    {
+        int op = code[i].OP_type;
+        long long val = code[i].val;
+
+        valid = op >= 0 && op < OP_HALT && code[i].off > -OFF_MAX && code[i].off < OFF_MAX;
+
+        // nor spin in a scan that never moves, or step a move past the guard
+        if (op == OP_SKPR || op == OP_SKPL) valid = valid && val >= 1 && val < OFF_MAX;
+        if (op == OP_MOVR || op == OP_MOVL) valid = valid && val >= 0 && val < OFF_MAX;
+        if (op == OP_SCAN || op == OP_PRNT) valid = valid && val >= 0;
+
+        if (op == OP_JMPL) stack[depth++] = i;
+        if (op == OP_JMPR) valid = valid && depth > 0 && val == stack[--depth] && code[val].val == i;
+        valid = valid && positions[i] >= 0 && positions[i] < length;
+    }
+
+    valid = valid && depth == 0;
+    free(stack);
+
+    // nor the profilers off the end of the source
+    for (long long i = 0; valid && i < line_count; i++)
+        valid = lines[i] >= 0 && lines[i] <= length && (i == 0 ? lines[i] == 0 : lines[i] > lines[i - 1]);
+
+    if (!valid)
+    {
+        munmap(data, info.st_size);
+        return -1;
+    }
+
+    program->bytecode = code;
+    program->positions = (long long *) positions;
+    program->lines = (long long *) lines;
+    program->line_count = line_count;
+    program->mapped = info.st_size;
+    return code_length;
+}
+
+// writes to a temporary file and renames it, so runs sharing the cache only ever see whole files
+static void cache_store(BF *bf, const BF_PROGRAM *program, uint64_t key, long long length)
+{
+    long long bytecode_length = program->length;
+
+    char path[PATH_MAX], temp[PATH_MAX + 8];
+
+    // create the directory and any missing parents, failing here just means no caching
+    snprintf(temp, sizeof(temp), "%s/", bf->cache_dir);
+    for (char *slash = strchr(temp + 1, '/'); slash != NULL; slash = strchr(slash + 1, '/'))
+    {
+        *slash = '\0';
+        mkdir(temp, 0700);
+        *slash = '/';
+    }
+
+    cache_path(bf, path, key);
+    snprintf(temp, sizeof(temp), "%s.XXXXXX", path);
+
+    int fd = mkstemp(temp);
+    if (fd < 0) return;
+
+    CACHE_HEADER header = {"BFC", CACHE_VERSION, key, length, bytecode_length, program->line_count};
+    struct iovec iov[4] = {
+        {&header, sizeof(header)},
+        {program->bytecode, sizeof(INS) * (bytecode_length + 1)},
+        {program->positions, sizeof(int64_t) * (bytecode_length + 1)},
+        {program->lines, sizeof(int64_t) * program->line_count}
+    };
+
+    ssize_t expected = iov[0].iov_len + iov[1].iov_len + iov[2].iov_len + iov[3].iov_len;
+    bool written = writev(fd, iov, 4) == expected;
+
+    if (close(fd) == 0 && written) rename(temp, path);
+    else unlink(temp);
+}
+
+static int get_op(char c)
+{
+    switch(c) 
+    {
+        case '+': return OP_ADDN;
+        case '-': return OP_SUBN;
+        case '>': return OP_MOVR;
+        case '<': return OP_MOVL;
+        case '.': return OP_PRNT;
+        case ',': return OP_SCAN;
+        case '[': return OP_JMPL;
+        case ']': return OP_JMPR;
+        default:  return OP_NULL;
+    }
+}
+
+// the get_ functions return -1 (NULL for get_eof) for a name they don't know
+static int get_engine(const char *name)
+{
+    if (strcmp(name, "switch") == 0) return ENGINE_SWITCH;
+    if (strcmp(name, "threaded") == 0) return ENGINE_THREADED;
+    if (strcmp(name, "jit") == 0) return ENGINE_JIT;
+    if (strcmp(name, "tiered") == 0) return ENGINE_TIERED;
+    if (strcmp(name, "packed") == 0) return ENGINE_PACKED;
+
+    return -1;
+}
+
+static int get_flush(const char *name)
+{
+    if (strcmp(name, "full") == 0) return FLUSH_FULL;
+    if (strcmp(name, "line") == 0) return FLUSH_LINE;
+    if (strcmp(name, "read") == 0) return FLUSH_READ;
+
+    return -1;
+}
+
+static void (*get_eof(const char *name))(byte *cell)
+{
+    if (strcmp(name, "unchanged") == 0) return in_eof_unchanged;
+    if (strcmp(name, "0") == 0) return in_eof_zero;
+    if (strcmp(name, "255") == 0) return in_eof_max;
+
+    return NULL;
+}
+
+// a whole number from 0 up, written out in full: a limit that doesn't parse mustn't turn into no limit
+static long long get_count(const char *text)
+{
+    char *end;
+    errno = 0;
+    long long count = strtoll(text, &end, 10);
+
+    if (end == text || *end != '\0' || errno == ERANGE || count < 0) return -1;
+    return count;
+}
+
+// seconds from 0 up to a billion (so they fit in nanoseconds), -1 for anything else
+static double get_seconds(const char *text)
+{
+    char *end;
+    double seconds = strtod(text, &end);
+
+    if (end == text || *end != '\0' || !(seconds >= 0 && seconds <= 1e9)) return -1;
+    return seconds;
+}
+
+// enables only the comma separated passes in `names`, or all of them for "all"
+static bool set_passes(BF *bf, const char *names)
+{
+    unsigned enabled = 0;
+
+    if (strcmp(names, "all") == 0) {
+        bf->passes = (1u << PASS_COUNT) - 1;
+        return true;
+    }
+
+    while (*names != '\0')
+    {
+        size_t length = strcspn(names, ",");
+        int i;
+
+        for (i = 0; i < PASS_COUNT; i++) 
+            if (strlen(passes[i].name) == length && strncmp(passes[i].name, names, length) == 0) break;
+
+        if (i == PASS_COUNT) return false;
+        enabled |= 1u << i;
+
+        names += length;
+        if (*names == ',') names++;
+    }
+
+    bf->passes = enabled;
+    return true;
+}
+
+void bf_dump(const BF_PROGRAM *program, FILE *stream)
+{
+    const INS *bytecode = program->bytecode;
+
+    for (long long i = 0; i < program->length; i++)
+    {
+        long long line, column;
+        bf_place(program, i, &line, &column);
+
+        int width = fprintf(stream, "%6lli  %s %lli", i, op_names[bytecode[i].OP_type], bytecode[i].val);
+        if (bytecode[i].off != 0) width += fprintf(stream, " [%+i]", bytecode[i].off);
+        fprintf(stream, "%*s%lli:%lli\n", max(32 - width, 1), "", line, column);
+    }
+}
@@ -0,0 +1,135 @@
+#ifndef LIBBF_H
+#define LIBBF_H
+
+/*
+ * libbf: the compiler and engines behind bf, for programs that want to run brainf
+ * without starting a process per job. compile a program once, then run it as often
+ * as needed, from any number of contexts, against stdin/stdout or buffers.
+ *
+ *     BF *bf = bf_create();
+ *     BF_PROGRAM *program = bf_compile(bf, source, length, NULL);
+ *     bf_run_buffers(bf, program, input, input_length, output, sizeof(output), &output_length);
+ *     bf_free_program(program);
+ *     bf_destroy(bf);
+ *
+ * the calls here only ever change by being added to, LIBBF_VERSION counts the additions.
+ * running out of memory still ends the process, as it does for bf.
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LIBBF_VERSION 8
+
+// an interpreter: its settings, tape and I/O. use one per thread.
+typedef struct BF BF;
+
+// a compiled program, shared freely between contexts and threads
+typedef struct BF_PROGRAM BF_PROGRAM;
+
+// what the bf_run calls return
+enum BF_STATUS {
+    BF_OK,
+    BF_OUTPUT_FULL,   // the output didn't fit the caller's buffer, the rest was dropped
+    BF_TAPE_ERROR,    // the pointer moved off the tape, the run stopped there
+    BF_OUTPUT_CLOSED, // the caller's writer refused output, the rest was dropped
+    BF_STEP_LIMIT,    // the run went round its loops max-steps times and was stopped
+    BF_TIME_LIMIT     // the run took longer than timeout seconds and was stopped
+};
+
+// takes a piece of output for bf_run_stream, false if it can't take any more
+typedef bool (*BF_WRITE)(void *context, const unsigned char *data, size_t length);
+
+BF  *bf_create(void);
+void bf_destroy(BF *bf);
+
+/*
+ * sets one of the command line's long options on the context, named without the dashes:
+ * engine, passes (a list or "all"), tier-threshold, tape-size, flush, eof, max-steps,
+ * timeout (in seconds), profile=on|off, sample-rate (a second, 0 for off) and cache-dir
+ * (NULL turns the cache off, the default).
+ * input=stdio makes , read through getchar for hosts that read stdin with stdio
+ * themselves. returns false for an unknown name or value, numbers included: they are
+ * whole numbers from 0, timeout's seconds can have a fraction. tape-size only applies to
+ * a context that hasn't run yet.
+ */
+bool bf_option(BF *bf, const char *name, const char *value);
+
+/*
+ * compiles `length` bytes of source with the context's passes and cache. returns NULL if
+ * the brackets don't match, with *error_point (if not NULL) set to the bad one.
+ */
+BF_PROGRAM *bf_compile(BF *bf, const char *source, long long length, long long *error_point);
+void        bf_free_program(BF_PROGRAM *program);
+
+/*
+ * gets the context ready to run `program`: maps the tape and makes the jit or packed code
+ * the engine needs, which the context keeps for as long as it runs the same program.
+ * runs do this themselves, calling it first is for a process about to fork workers.
+ */
+void bf_prepare(BF *bf, const BF_PROGRAM *program);
+
+// runs on stdin and stdout, keeping the tape and pointer from the context's last bf_run
+int bf_run(BF *bf, const BF_PROGRAM *program);
+
+/*
+ * runs from a blank tape, reading `input` and writing at most `output_capacity` bytes to
+ * `output`. *output_length (if not NULL) gets how many were written.
+ */
+int bf_run_buffers(BF *bf, const BF_PROGRAM *program, const unsigned char *input, size_t input_length,
+                   unsigned char *output, size_t output_capacity, size_t *output_length);
+
+// runs from a blank tape, reading and writing file descriptors the caller opened
+int bf_run_fds(BF *bf, const BF_PROGRAM *program, int input, int output);
+
+// runs from a blank tape, reading `input` and handing output to `write` as it is flushed
+int bf_run_stream(BF *bf, const BF_PROGRAM *program, const unsigned char *input, size_t input_length,
+                  BF_WRITE write, void *context);
+
+/*
+ * about the context's last run: the loop passes it took, each time it went through a ]
+ * counts one, and the instruction a budget or the tape stopped it at, -1 if neither did.
+ * jit code (all of the jit engine's run, the loops the tiered engine compiled) only
+ * counts passes when max-steps or timeout is set, without either its passes are left out.
+ * only the jit engine knows which instruction moved off the tape, the others leave it -1.
+ */
+long long bf_steps(const BF *bf);
+long long bf_stopped_at(const BF *bf);
+
+/*
+ * where in the source `instruction` came from, as an offset (-1 past the end) or as a
+ * 1-based line and column (false past the end). compiled and cached programs both keep
+ * this, so neither needs the source.
+ */
+long long bf_position(const BF_PROGRAM *program, long long instruction);
+bool bf_place(const BF_PROGRAM *program, long long instruction, long long *line, long long *column);
+
+/*
+ * with profile=on, runs count every instruction they execute. this prints the `loops`
+ * loops of `program` that ran the most, with their share of all instructions run, their
+ * passes and entries, and where they are. `source` (the program's, or NULL) adds their text.
+ */
+void bf_profile(const BF *bf, const BF_PROGRAM *program, const char *source, FILE *stream, int loops);
+
+/*
+ * with sample-rate set, runs are sampled that often a second of cpu time through SIGPROF,
+ * which only one context in the process can use at a time. this writes the samples of
+ * `program` as folded stacks for flame graph tools, `root` first on every line, and
+ * returns how many there were. jit code is placed down to the instruction, the other
+ * engines only down to the loop whose [ or ] they last went through.
+ */
+long long bf_samples(const BF *bf, const BF_PROGRAM *program, const char *source, const char *root, FILE *stream);
+
+// prints the program's bytecode, one instruction a line with the line:column it came from
+void bf_dump(const BF_PROGRAM *program, FILE *stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
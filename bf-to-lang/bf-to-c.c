@@ -3,11 +3,16 @@
 #include <stdbool.h>
 #include <sys/stat.h>
 #include <string.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
 
 typedef struct node
 {
     char ins;
-    long long int count; // times instruction is repeated
+    long long int count; // times instruction is repeated, or the constant for '=' and the factor for '*'
+    long long int off;   // offset of the cell the instruction works on, '*' adds to it
     struct node *next;
 } Node;
 
@@ -22,15 +27,253 @@ typedef struct node
 // iterate through the list with a pointer
 #define for_each_node_ref(head, it) for (Node *it = head; it != NULL; it = it->next)
 
+/*
+ * written into every program: buffered input and output for , and .
+ */
+const char *io_runtime = 
+    "/*\n"
+    " * what . prints is collected in `out` and written with write(2). BF_FLUSH picks when:\n"
+    " * full (when the buffer fills), line (after every newline) or read (before every ,).\n"
+    " * it is line on a terminal and full otherwise, reads from a terminal always flush first.\n"
+    " * , reads stdin a block at a time into `in`, BF_EOF picks what it stores at the end of\n"
+    " * the input: unchanged, 0 or 255.\n"
+    " */\n"
+    "byte out[1 << 16], in[1 << 16];\n"
+    "long long out_length, in_length, in_pos;\n"
+    "char out_policy, out_interactive, in_eof = '2';\n"
+    "\n"
+    "void out_init(void)\n"
+    "{\n"
+    "    out_policy = isatty(STDOUT_FILENO) ? 'l' : 'f';\n"
+    "    if (getenv(\"BF_FLUSH\") != NULL) out_policy = getenv(\"BF_FLUSH\")[0];\n"
+    "    out_interactive = isatty(STDIN_FILENO);\n"
+    "    if (getenv(\"BF_EOF\") != NULL) in_eof = getenv(\"BF_EOF\")[0];\n"
+    "}\n"
+    "\n"
+    "void out_flush(void)\n"
+    "{\n"
+    "    for (byte *data = out; out_length > 0; )\n"
+    "    {\n"
+    "        ssize_t written = write(STDOUT_FILENO, data, out_length);\n"
+    "\n"
+    "        if (written < 0 && errno == EINTR) continue;\n"
+    "        if (written < 0) break;\n"
+    "\n"
+    "        data += written;\n"
+    "        out_length -= written;\n"
+    "    }\n"
+    "\n"
+    "    out_length = 0;\n"
+    "}\n"
+    "\n"
+    "void put(byte c)\n"
+    "{\n"
+    "    out[out_length++] = c;\n"
+    "    if (out_length == sizeof(out) || (c == '\\n' && out_policy == 'l')) out_flush();\n"
+    "}\n"
+    "\n"
+    "byte get(byte cell)\n"
+    "{\n"
+    "    if (out_policy == 'r' || out_interactive) out_flush();\n"
+    "    if (in_pos < in_length) return in[in_pos++];\n"
+    "\n"
+    "    do in_length = read(STDIN_FILENO, in, sizeof(in));\n"
+    "    while (in_length < 0 && errno == EINTR);\n"
+    "\n"
+    "    in_pos = 0;\n"
+    "    if (in_length > 0) return in[in_pos++];\n"
+    "\n"
+    "    in_length = 0;\n"
+    "    return (in_eof == 'u') ? cell : (in_eof == '0') ? 0 : 255;\n"
+    "}\n"
+    "\n";
+
+/*
+ * written into every program: the tape and the SIGSEGV handler that grows it.
+ * the same scheme as bf-interpreter/bf.c
+ */
+const char *tape_runtime = 
+    "/*\n"
+    " * the tape is reserved up front and committed as the program walks into it,\n"
+    " * guard regions on both ends stop it from running off. BF_TAPE_SIZE sets how many\n"
+    " * cells it can grow to.\n"
+    " */\n"
+    "byte *tape, *tape_base;\n"
+    "long long tape_committed, tape_limit = 1ll << 28, tape_page, tape_guard = 1ll << 30;\n"
+    "\n"
+    "void tape_fault(int sig, siginfo_t *info, void *context)\n"
+    "{\n"
+    "    (void) context;\n"
+    "    byte *addr = info->si_addr;\n"
+    "\n"
+    "    if (addr >= tape + tape_committed && addr < tape + tape_limit)\n"
+    "    {\n"
+    "        long long want = (addr - tape + 1 > 2 * tape_committed) ? addr - tape + 1 : 2 * tape_committed;\n"
+    "        want = (want + tape_page - 1) / tape_page * tape_page;\n"
+    "        if (want > tape_limit) want = tape_limit;\n"
+    "\n"
+    "        if (mprotect(tape + tape_committed, want - tape_committed, PROT_READ | PROT_WRITE) == 0)\n"
+    "        {\n"
+    "            tape_committed = want;\n"
+    "            return;\n"
+    "        }\n"
+    "    }\n"
+    "\n"
+    "    if (addr >= tape_base && addr < tape + tape_limit + tape_guard)\n"
+    "    {\n"
+    "        static const char message[] = \"Error: pointer moved off the tape.\\n\";\n"
+    "\n"
+    "        out_flush();\n"
+    "        write(STDOUT_FILENO, message, sizeof(message) - 1);\n"
+    "        _exit(4);\n"
+    "    }\n"
+    "\n"
+    "    signal(sig, SIG_DFL);\n"
+    "}\n"
+    "\n"
+    "void tape_init(void)\n"
+    "{\n"
+    "    // a tape of no cells can't run anything, so only a whole number above 0 will do\n"
+    "    const char *size = getenv(\"BF_TAPE_SIZE\");\n"
+    "    if (size != NULL)\n"
+    "    {\n"
+    "        char *end;\n"
+    "        errno = 0;\n"
+    "        tape_limit = strtoll(size, &end, 10);\n"
+    "        if (end == size || *end != '\\0' || errno != 0 || tape_limit <= 0)\n"
+    "        {\n"
+    "            printf(\"Error: bad value for BF_TAPE_SIZE [%s].\\n\", size);\n"
+    "            exit(1);\n"
+    "        }\n"
+    "    }\n"
+    "\n"
+    "    tape_page = sysconf(_SC_PAGESIZE);\n"
+    "    tape_limit = (tape_limit + tape_page - 1) / tape_page * tape_page;\n"
+    "    tape_committed = (tape_limit < (1 << 16)) ? tape_limit : (1 << 16);\n"
+    "\n"
+    "    // guard, the cells, guard\n"
+    "    tape_base = mmap(NULL, tape_limit + 2 * tape_guard, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);\n"
+    "    if (tape_base == MAP_FAILED) exit(2);\n"
+    "\n"
+    "    tape = tape_base + tape_guard;\n"
+    "    if (mprotect(tape, tape_committed, PROT_READ | PROT_WRITE) != 0) exit(2);\n"
+    "\n"
+    "    stack_t stack = {.ss_sp = malloc(SIGSTKSZ), .ss_size = SIGSTKSZ, .ss_flags = 0};\n"
+    "    sigaltstack(&stack, NULL);\n"
+    "\n"
+    "    struct sigaction action = {0};\n"
+    "    action.sa_sigaction = tape_fault;\n"
+    "    action.sa_flags = SA_SIGINFO | SA_ONSTACK;\n"
+    "    sigaction(SIGSEGV, &action, NULL);\n"
+    "}\n"
+    "\n";
+
+/*
+ * written into programs that use [>] or [<]. they look at the first 8 cells one by one,
+ * most scans stop there, then at 64 cells per step: `lanes` marks the cells a step can
+ * stop on and the window moves by that many strides.
+ */
+const char *scan_helpers = 
+    "#ifdef __SSE2__\n"
+    "// bit k is set when cells[k] == 0\n"
+    "unsigned long long zero_mask(const byte *cells)\n"
+    "{\n"
+    "    unsigned long long mask = 0;\n"
+    "\n"
+    "    for (int k = 0; k < 4; k++)\n"
+    "        mask |= (unsigned long long) (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (cells + 16 * k)), _mm_setzero_si128())) << (16 * k);\n"
+    "\n"
+    "    return mask;\n"
+    "}\n"
+    "#endif\n"
+    "\n"
+    "// searches what is committed, reading the next cell then grows the tape\n"
+    "long long scan_right(long long index, long long stride)\n"
+    "{\n"
+    "    for (int k = 0; k < 8; k++, index += stride)\n"
+    "        if (tape[index] == 0) return index;\n"
+    "\n"
+    "    unsigned long long lanes = 0;\n"
+    "    long long window = 0;\n"
+    "\n"
+    "    while (tape[index])\n"
+    "    {\n"
+    "        if (stride == 1)\n"
+    "        {\n"
+    "            byte *zero = memchr(tape + index, 0, tape_committed - index);\n"
+    "            if (zero != NULL) return zero - tape;\n"
+    "            index = tape_committed;\n"
+    "            continue;\n"
+    "        }\n"
+    "\n"
+    "#ifdef __SSE2__\n"
+    "        if (lanes == 0) for (window = 0; window < 64; window += stride) lanes |= 1ull << window;\n"
+    "\n"
+    "        for (; stride < 64 && index + 64 <= tape_committed; index += window)\n"
+    "        {\n"
+    "            unsigned long long hits = zero_mask(tape + index) & lanes;\n"
+    "            if (hits) return index + __builtin_ctzll(hits);\n"
+    "        }\n"
+    "#endif\n"
+    "\n"
+    "        while (index < tape_committed && tape[index]) index += stride;\n"
+    "        if (index < tape_committed) return index;\n"
+    "    }\n"
+    "\n"
+    "    return index;\n"
+    "}\n"
+    "\n"
+    "long long scan_left(long long index, long long stride)\n"
+    "{\n"
+    "    for (int k = 0; k < 8; k++, index -= stride)\n"
+    "        if (tape[index] == 0) return index;\n"
+    "\n"
+    "#ifdef __SSE2__\n"
+    "    if (stride < 64 && index >= 63)\n"
+    "    {\n"
+    "        unsigned long long lanes = 0;\n"
+    "        long long window;\n"
+    "\n"
+    "        for (window = 0; window < 64; window += stride) lanes |= 1ull << (63 - window);\n"
+    "\n"
+    "        for (; index >= 63; index -= window)\n"
+    "        {\n"
+    "            unsigned long long hits = zero_mask(tape + index - 63) & lanes;\n"
+    "            if (hits) return index - __builtin_clzll(hits);\n"
+    "        }\n"
+    "    }\n"
+    "#endif\n"
+    "\n"
+    "    while (tape[index]) index -= stride;\n"
+    "    return index;\n"
+    "}\n"
+    "\n";
 
-bool file_exists(char *filename);
 
 // utilities for parsing the *.bf file
-// filters out all unrelated characters
-Node *parse_file(FILE *fp, char *input); 
+// maps the file, or reads it in blocks if it can't be mapped. *mapped is 0 for a malloc'd buffer
+char *load_file(char *filename, long long int *length, long long int *mapped);
 
-// organizes repeated commands into a list
-Node *optimize(long long int len, char *input); 
+// true for the 8 commands, everything else is a comment
+bool is_command(char c);
+
+// organizes repeated commands into a list, skipping comments
+Node *optimize(long long int len, const char *input); 
+
+// replaces [-] and [+] with a '=' node that sets the cell to a constant
+void find_clear_loops(Node *head);
+
+// replaces balanced loops like [->+>++<<] with a '*' node per target cell and a '=' node
+void find_multiply_loops(Node *head);
+
+// replaces [>] and [<] of any stride with a 'r' or 'l' node, count is the stride
+void find_scan_loops(Node *head);
+
+// gives straight-line instructions the offset of their cell and moves the pointer once per block
+void find_offsets(Node *head);
+
+// folds the +/- run after a '=' node into its constant
+void fold_constant(Node *set);
 
 // uses list to write the file
 void write_file(char *old_name, Node *head);
@@ -42,114 +285,318 @@ void free_list(Node *head);
 // note: moves cur
 void add_node(Node **_cur, char _ins, long long int _count); 
 
+// note: also frees the removed node
+void remove_next(Node *cur);
+
 
 int main(int argc, char* argv[])
 {
     // error checking for file
     THROW_IF(argc != 2, 1,
-            "Usage: '%s [file.bf]'.\n", argv[0]);
-    THROW_IF(!file_exists(argv[1]), 2,
-            "Error: filename is wrong or does not exist (%s).\n", argv[1]);
-
-	FILE* rptr = fopen(argv[1], "r");
+            "Usage: '%s [file.bf]', '-' reads stdin and writes stdin.c.\n", argv[0]);
 
-    THROW_IF(rptr == NULL, 3,
-            "Error: file pointer NULL (%s).\n", argv[1]);
-
-    // get file length
-    fseek(rptr, 0, SEEK_END);
-    long long int length = ftell(rptr);
-    fseek(rptr, 0, SEEK_SET);
+    long long int length, mapped;
+    char *input = load_file(argv[1], &length, &mapped);
 
     THROW_IF(length == 0, EXIT_FAILURE,
             "Error: file is empty (%s).\n", argv[1]);
 
-    char *input = (char *) malloc(length + 1);
+    Node *head = optimize(length, input);
 
-    Node *head = parse_file(rptr, input);
+    find_clear_loops(head);
+    find_multiply_loops(head);
+    find_scan_loops(head);
+    find_offsets(head);
 
-    write_file(argv[1], head);
+    write_file((strcmp(argv[1], "-") == 0) ? "stdin.bf" : argv[1], head);
 
     // exit program
-    fclose(rptr);
+    if (mapped > 0) munmap(input, mapped);
+    else free(input);
 
-    free(input);
     free_list(head);
 
     return 0;
 }
 
-// file_exists written by codebunny & Adam Liss @ https://stackoverflow.com/a/230070
-bool file_exists(char *filename)
+char *load_file(char *filename, long long int *length, long long int *mapped)
 {
-    struct stat buffer;
-    return (stat(filename, &buffer) == 0);
-}
+    int fd = (strcmp(filename, "-") == 0) ? STDIN_FILENO : open(filename, O_RDONLY);
 
-Node *parse_file(FILE *fp, char *input)
-{
-    char tmp;
-    long long int read_ind = 0;
+    THROW_IF(fd < 0, 2,
+            "Error: filename is wrong or does not exist (%s).\n", filename);
 
-    while((tmp = fgetc(fp)) != EOF)
+    struct stat info;
+    THROW_IF(fstat(fd, &info) != 0, 3,
+            "Error: unable to read (%s).\n", filename);
+
+    *mapped = 0;
+
+    // a regular file is lexed straight from the page cache
+    if (S_ISREG(info.st_mode) && info.st_size > 0)
     {
-        // me when i am falling through cases
-        switch(tmp)
+        char *input = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (input != MAP_FAILED)
         {
-            case '+': // add
-            case '-': // subtract
-            case '>': // move right
-            case '<': // move left
-            case '.': // write char
-            case ',': // read char
-            case '[': // begin loop
-            case ']': // end loop
-                input[read_ind++] = tmp;
+            madvise(input, info.st_size, MADV_SEQUENTIAL);
+            close(fd);
+
+            *length = *mapped = info.st_size;
+            return input;
         }
     }
 
-    input[read_ind++] = '\0'; // add end-of-string char
-    
-    Node *head = optimize(read_ind, input);
-    return head;
+    // pipes and the like are read until they end
+    long long int capacity = 1 << 16;
+    char *input = (char *) malloc(capacity);
+    *length = 0;
+
+    while (input != NULL)
+    {
+        if (*length == capacity) input = (char *) realloc(input, capacity *= 2);
+        if (input == NULL) break;
+
+        ssize_t got = read(fd, input + *length, capacity - *length);
+
+        if (got < 0 && errno == EINTR) continue;
+        THROW_IF(got < 0, 3,
+                "Error: unable to read (%s).\n", filename);
+        if (got == 0) break;
+
+        *length += got;
+    }
+
+    THROW_IF(input == NULL, 3,
+            "Error: unable to allocate memory.\n");
+
+    close(fd);
+    return input;
+}
+
+bool is_command(char c)
+{
+    // me when i am falling through cases
+    switch(c)
+    {
+        case '+': // add
+        case '-': // subtract
+        case '>': // move right
+        case '<': // move left
+        case '.': // write char
+        case ',': // read char
+        case '[': // begin loop
+        case ']': // end loop
+            return true;
+    }
+
+    return false;
 }
 
-Node *optimize(long long int length, char *input)
+Node *optimize(long long int length, const char *input)
 {
     Node *head = (Node *) malloc(sizeof(Node));
     *head = (Node) {
         .ins = 'x',
         .count = 0,
+        .off = 0,
         .next = NULL
     };
 
     Node *cur = head;
-    long long int prev_count = 1;
+    long long int prev_count = 0;
     long long int cur_layer = 0;
+    char prev = '\0';
 
-    if (input[0] == '[') cur_layer++;
-    else if (input[0] == ']') cur_layer--;
-    
-    for (long long int i = 1; i < length; i++)
+    for (long long int i = 0; i < length; i++)
     {
-        THROW_IF(cur_layer < 0, -1, "Error: Invalid square bracket syntax.\n");
-        
+        if (!is_command(input[i])) continue;
+
         if (input[i] == '[') cur_layer++;
         else if (input[i] == ']') cur_layer--;
 
-        if (input[i - 1] != input[i])
+        THROW_IF(cur_layer < 0, -1, "Error: Invalid square bracket syntax.\n");
+
+        // brackets always get their own node so loops can be matched one by one
+        if (prev_count > 0 && (prev != input[i] || prev == '[' || prev == ']'))
         {
-            add_node(&cur, input[i - 1], prev_count);
+            add_node(&cur, prev, prev_count);
             prev_count = 0;
         }
+
+        prev = input[i];
         prev_count++;
     }
 
+    if (prev_count > 0) add_node(&cur, prev, prev_count);
+
     THROW_IF(cur_layer != 0, -1, "Error: Invalid square bracket syntax.\n");
 
     return head;
 }
 
+void find_clear_loops(Node *head)
+{
+    for_each_node_ref(head, it)
+    {
+        Node *body = it->next;
+
+        if (it->ins != '[' || body == NULL || (body->ins != '-' && body->ins != '+')) continue;
+        
+        // any odd step reaches 0 eventually, an even one might loop forever
+        if (body->count % 2 == 0 || body->next == NULL || body->next->ins != ']') continue;
+
+        it->ins = '=';
+        it->count = 0;
+        remove_next(it);
+        remove_next(it);
+
+        fold_constant(it);
+    }
+}
+
+void find_multiply_loops(Node *head)
+{
+    for_each_node_ref(head, it)
+    {
+        if (it->ins != '[') continue;
+
+        // the body can only be +-<> and has to end where it started
+        long long int pos = 0, length = 0;
+        Node *end = it->next;
+
+        for (; end != NULL && strchr("+-<>", end->ins) != NULL; end = end->next, length++)
+        {
+            if (end->ins == '>') pos += end->count;
+            else if (end->ins == '<') pos -= end->count;
+        }
+
+        if (end == NULL || end->ins != ']' || pos != 0) continue;
+
+        // net change of every cell the body touches, cells[0] is the loop's own cell
+        long long int *offsets = (long long int *) malloc(sizeof(long long int) * (length + 1));
+        long long int *changes = (long long int *) malloc(sizeof(long long int) * (length + 1));
+        long long int cells = 1;
+
+        THROW_IF(offsets == NULL || changes == NULL, EXIT_FAILURE, "Error allocating loop analysis.\n");
+
+        offsets[0] = changes[0] = 0;
+
+        for (Node *body = it->next; body != end; body = body->next)
+        {
+            if (body->ins == '>') pos += body->count;
+            else if (body->ins == '<') pos -= body->count;
+            else
+            {
+                long long int cell = 0;
+                while (cell < cells && offsets[cell] != pos) cell++;
+                if (cell == cells) 
+                {
+                    offsets[cells] = pos;
+                    changes[cells++] = 0;
+                }
+
+                changes[cell] += (body->ins == '+') ? body->count : -body->count;
+            }
+        }
+
+        long long int step = ((changes[0] % 256) + 256) % 256;
+
+        if (step == 1 || step == 255)
+        {
+            // drop the body and the closing bracket, '[' becomes the first new node
+            while (it->next != end) remove_next(it);
+            remove_next(it);
+
+            Node *cur = it;
+            bool first = true;
+
+            for (long long int cell = 1; cell < cells; cell++)
+            {
+                // stepping up by one runs (256 - cell) times, which is -cell mod 256
+                long long int factor = (step == 255) ? changes[cell] : -changes[cell];
+                factor = ((factor % 256) + 256) % 256;
+
+                if (factor == 0) continue;
+
+                if (first) *it = (Node) { .ins = '*', .count = factor, .off = offsets[cell], .next = it->next };
+                else 
+                {
+                    add_node(&cur, '*', factor);
+                    cur->off = offsets[cell];
+                }
+                first = false;
+            }
+
+            if (first) *it = (Node) { .ins = '=', .count = 0, .off = 0, .next = it->next };
+            else add_node(&cur, '=', 0);
+
+            fold_constant(cur);
+        }
+
+        free(offsets);
+        free(changes);
+    }
+}
+
+void find_scan_loops(Node *head)
+{
+    for_each_node_ref(head, it)
+    {
+        Node *body = it->next;
+
+        if (it->ins != '[' || body == NULL || (body->ins != '>' && body->ins != '<')) continue;
+        if (body->next == NULL || body->next->ins != ']') continue;
+
+        it->ins = (body->ins == '>') ? 'r' : 'l';
+        it->count = body->count;
+        remove_next(it);
+        remove_next(it);
+    }
+}
+
+void find_offsets(Node *head)
+{
+    long long int pos = 0;
+
+    // last node that stays in the list
+    Node *last = head;
+
+    for (Node *it = head->next; ; it = last->next)
+    {
+        // loops, scans and multiplies need the real pointer, so they end the block
+        if (it == NULL || strchr("[]rl*", it->ins) != NULL)
+        {
+            if (pos != 0) add_node(&last, (pos > 0) ? '>' : '<', (pos > 0) ? pos : -pos);
+            pos = 0;
+
+            if (it == NULL) break;
+            last = it;
+        }
+        else if (it->ins == '>' || it->ins == '<')
+        {
+            pos += (it->ins == '>') ? it->count : -it->count;
+            remove_next(last);
+        }
+        else
+        {
+            it->off = pos;
+            last = it;
+        }
+    }
+}
+
+void fold_constant(Node *set)
+{
+    if (set->next != NULL && (set->next->ins == '+' || set->next->ins == '-'))
+    {
+        long long int change = set->next->count % 256;
+
+        set->count = (set->next->ins == '+') ? change : (256 - change) % 256;
+        remove_next(set);
+    }
+}
+
 void write_file(char *old_name, Node *head)
 {
     /*
@@ -175,35 +622,61 @@ void write_file(char *old_name, Node *head)
 
 
     // current number of tabs inside the loops
-    unsigned int layer = 0;
+    int layer = 0;
 
     // pre-written translation commands
+    // %s is the cell the instruction works on
     char *text[4] = {
-        "putchar(tape[index]);\n",    // '.'
-        "tape[index] = getchar();\n", // ','
-        "while(tape[index]) {\n",     // '['
-        "}\n"                         // ']'
+        "put(%s);\n",       // '.'
+        "%s = get(%s);\n",  // ','
+        "while(%s) {\n",     // '['
+        "}\n"                // ']'
     };
 
+    // e.g. tape[index] or tape[index+3]
+    char cell[32];
+
     // how much to change the layer by
     int layer_off;
 
     // temporary char used for '>' and '<' commands
     char tmp;
 
+    // scan helpers are only written if the program needs them
+    bool scans = false;
+    for_each_node_ref(head, it) 
+        if (it->ins == 'r' || it->ins == 'l') scans = true;
+
     // program header
     fprintf(wptr, "// <Autogenerated>\n"
                 "#include <stdio.h>\n"
+                "#include <stdlib.h>\n"
+                "#include <signal.h>\n"
+                "#include <unistd.h>\n"
+                "#include <sys/mman.h>\n"
+                "#include <errno.h>\n"
+                "%s"
                 "\n"
                 "typedef unsigned char byte;\n"
-                "\n"
-                "byte tape[30000] = {0};\n"
-                "\n"
-                "int main(void)\n"
+                "\n",
+                scans ? "#include <string.h>\n"
+                        "#ifdef __SSE2__\n"
+                        "#include <emmintrin.h>\n"
+                        "#endif\n" : "");
+
+    fprintf(wptr, "%s", io_runtime);
+    fprintf(wptr, "%s", tape_runtime);
+    if (scans) fprintf(wptr, "%s", scan_helpers);
+
+    fprintf(wptr, "int main(void)\n"
                 "{\n");
-    write_tabs(wptr, 1); fprintf(wptr, "int index = 0;\n");
+    write_tabs(wptr, 1); fprintf(wptr, "long long index = 0;\n");
+    write_tabs(wptr, 1); fprintf(wptr, "out_init();\n");
+    write_tabs(wptr, 1); fprintf(wptr, "tape_init();\n");
     write_tabs(wptr, 1); fprintf(wptr, "// START\n");
 
+    char previous = '\0'; // the last node written, a run of '*' shares one test
+
     for_each_node_ref(head, it)
     {
         char ins = it->ins;
@@ -212,6 +685,9 @@ void write_file(char *old_name, Node *head)
         // index of pre-written commands to choose
         int text_index = -1;
 
+        if (it->off == 0) strcpy(cell, "tape[index]");
+        else snprintf(cell, sizeof(cell), "tape[index%+lld]", it->off);
+
         // indent lines
         if (ins == ']') write_tabs(wptr, layer);
         else write_tabs(wptr, layer + 1);
@@ -221,9 +697,9 @@ void write_file(char *old_name, Node *head)
             case '+':
             case '-':
                 if (count == 1) // -- or ++
-                    fprintf(wptr, "tape[index]%c%c;\n", ins, ins); 
+                    fprintf(wptr, "%s%c%c;\n", cell, ins, ins); 
                 else // -= or +=
-                    fprintf(wptr, "tape[index] %c= %lld;\n", ins, count); 
+                    fprintf(wptr, "%s %c= %lld;\n", cell, ins, count); 
                 break;
             case '>':
             case '<':
@@ -234,6 +710,33 @@ void write_file(char *old_name, Node *head)
                 else // -= or +=
                     fprintf(wptr, "index %c= %lld;\n", tmp, count); 
                 break;
+            case '=':
+                fprintf(wptr, "%s = %lld;\n", cell, count);
+                break;
+            case 'r':
+            case 'l':
+                fprintf(wptr, "index = scan_%s(index, %lld);\n", (ins == 'r') ? "right" : "left", count);
+                break;
+            case '*':
+                // a loop's multiplies are skipped when its cell is 0, so they only touch cells it would
+                if (previous != '*')
+                {
+                    fprintf(wptr, "if (tape[index] != 0)\n");
+                    write_tabs(wptr, layer + 1); fprintf(wptr, "{\n");
+                    write_tabs(wptr, layer + 1);
+                }
+                write_tabs(wptr, 1);
+
+                // factors past 128 read better as a subtraction
+                fprintf(wptr, "%s %c= tape[index]", cell, (count <= 128) ? '+' : '-');
+                if (count != 1 && count != 255) fprintf(wptr, "*%lld", (count <= 128) ? count : 256 - count);
+                fprintf(wptr, ";\n");
+
+                if (it->next == NULL || it->next->ins != '*')
+                {
+                    write_tabs(wptr, layer + 1); fprintf(wptr, "}\n");
+                }
+                break;
             case '.':
                 text_index = 0;
                 layer_off = 0;
@@ -256,14 +759,17 @@ void write_file(char *old_name, Node *head)
         {   
             for (long long int i = 0; i < count; i++)
             {
-                fprintf(wptr, "%s", text[text_index]);
+                fprintf(wptr, text[text_index], cell, cell);
                 layer = layer + layer_off;
                 if (i < count - 1) write_tabs(wptr, layer + (layer_off >= 0));
             }
         }
+
+        previous = ins;
     }
 
     write_tabs(wptr, 1); fprintf(wptr, "// END\n");
+    write_tabs(wptr, 1); fprintf(wptr, "out_flush();\n");
     write_tabs(wptr, 1); fprintf(wptr, "return 0;\n"
                                 "}");
 
@@ -295,11 +801,12 @@ void add_node(Node **_cur, char _ins, long long int _count)
     THROW_IF(tmp == NULL, EXIT_FAILURE,
             "Error allocating node for list (0x%p)\n", tmp);
 
-    // create next node
+    // create next node, keeping whatever came after cur
     *tmp = (Node) {
         .ins = _ins,
         .count = _count,
-        .next = NULL
+        .off = 0,
+        .next = (*_cur)->next
     };
 
     // attach node to list
@@ -308,3 +815,11 @@ void add_node(Node **_cur, char _ins, long long int _count)
     // move cur to next in list
     *_cur = (*_cur)->next;
 }
+
+void remove_next(Node *cur)
+{
+    Node *tmp = cur->next;
+
+    cur->next = tmp->next;
+    free(tmp);
+}
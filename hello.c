@@ -1,57 +1,183 @@
 // <Autogenerated>
 #include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <errno.h>
 
 typedef unsigned char byte;
 
-byte tape[30000] = {0};
+/*
+ * what . prints is collected in `out` and written with write(2). BF_FLUSH picks when:
+ * full (when the buffer fills), line (after every newline) or read (before every ,).
+ * it is line on a terminal and full otherwise, reads from a terminal always flush first.
+ * , reads stdin a block at a time into `in`, BF_EOF picks what it stores at the end of
+ * the input: unchanged, 0 or 255.
+ */
+byte out[1 << 16], in[1 << 16];
+long long out_length, in_length, in_pos;
+char out_policy, out_interactive, in_eof = '2';
+
+void out_init(void)
+{
+    out_policy = isatty(STDOUT_FILENO) ? 'l' : 'f';
+    if (getenv("BF_FLUSH") != NULL) out_policy = getenv("BF_FLUSH")[0];
+    out_interactive = isatty(STDIN_FILENO);
+    if (getenv("BF_EOF") != NULL) in_eof = getenv("BF_EOF")[0];
+}
+
+void out_flush(void)
+{
+    for (byte *data = out; out_length > 0; )
+    {
+        ssize_t written = write(STDOUT_FILENO, data, out_length);
+
+        if (written < 0 && errno == EINTR) continue;
+        if (written < 0) break;
+
+        data += written;
+        out_length -= written;
+    }
+
+    out_length = 0;
+}
+
+void put(byte c)
+{
+    out[out_length++] = c;
+    if (out_length == sizeof(out) || (c == '\n' && out_policy == 'l')) out_flush();
+}
+
+byte get(byte cell)
+{
+    if (out_policy == 'r' || out_interactive) out_flush();
+    if (in_pos < in_length) return in[in_pos++];
+
+    do in_length = read(STDIN_FILENO, in, sizeof(in));
+    while (in_length < 0 && errno == EINTR);
+
+    in_pos = 0;
+    if (in_length > 0) return in[in_pos++];
+
+    in_length = 0;
+    return (in_eof == 'u') ? cell : (in_eof == '0') ? 0 : 255;
+}
+
+/*
+ * the tape is reserved up front and committed as the program walks into it,
+ * guard regions on both ends stop it from running off. BF_TAPE_SIZE sets how many
+ * cells it can grow to.
+ */
+byte *tape, *tape_base;
+long long tape_committed, tape_limit = 1ll << 28, tape_page, tape_guard = 1ll << 30;
+
+void tape_fault(int sig, siginfo_t *info, void *context)
+{
+    (void) context;
+    byte *addr = info->si_addr;
+
+    if (addr >= tape + tape_committed && addr < tape + tape_limit)
+    {
+        long long want = (addr - tape + 1 > 2 * tape_committed) ? addr - tape + 1 : 2 * tape_committed;
+        want = (want + tape_page - 1) / tape_page * tape_page;
+        if (want > tape_limit) want = tape_limit;
+
+        if (mprotect(tape + tape_committed, want - tape_committed, PROT_READ | PROT_WRITE) == 0)
+        {
+            tape_committed = want;
+            return;
+        }
+    }
+
+    if (addr >= tape_base && addr < tape + tape_limit + tape_guard)
+    {
+        static const char message[] = "Error: pointer moved off the tape.\n";
+
+        out_flush();
+        write(STDOUT_FILENO, message, sizeof(message) - 1);
+        _exit(4);
+    }
+
+    signal(sig, SIG_DFL);
+}
+
+void tape_init(void)
+{
+    // a tape of no cells can't run anything, so only a whole number above 0 will do
+    const char *size = getenv("BF_TAPE_SIZE");
+    if (size != NULL)
+    {
+        char *end;
+        errno = 0;
+        tape_limit = strtoll(size, &end, 10);
+        if (end == size || *end != '\0' || errno != 0 || tape_limit <= 0)
+        {
+            printf("Error: bad value for BF_TAPE_SIZE [%s].\n", size);
+            exit(1);
+        }
+    }
+
+    tape_page = sysconf(_SC_PAGESIZE);
+    tape_limit = (tape_limit + tape_page - 1) / tape_page * tape_page;
+    tape_committed = (tape_limit < (1 << 16)) ? tape_limit : (1 << 16);
+
+    // guard, the cells, guard
+    tape_base = mmap(NULL, tape_limit + 2 * tape_guard, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (tape_base == MAP_FAILED) exit(2);
+
+    tape = tape_base + tape_guard;
+    if (mprotect(tape, tape_committed, PROT_READ | PROT_WRITE) != 0) exit(2);
+
+    stack_t stack = {.ss_sp = malloc(SIGSTKSZ), .ss_size = SIGSTKSZ, .ss_flags = 0};
+    sigaltstack(&stack, NULL);
+
+    struct sigaction action = {0};
+    action.sa_sigaction = tape_fault;
+    action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+    sigaction(SIGSEGV, &action, NULL);
+}
 
 int main(void)
 {
-    int index = 0;
+    long long index = 0;
+    out_init();
+    tape_init();
     // START
         tape[index] += 10;
-    while(tape[index]) {
-        index++;
-        tape[index] += 7;
-        index++;
-        tape[index] += 10;
-        index++;
-        tape[index] += 3;
-        index++;
-        tape[index]++;
-        index -= 4;
-        tape[index]--;
+    if (tape[index] != 0)
+    {
+        tape[index+1] += tape[index]*7;
+        tape[index+2] += tape[index]*10;
+        tape[index+3] += tape[index]*3;
+        tape[index+4] += tape[index];
     }
-    index++;
-    tape[index] += 2;
-    putchar(tape[index]);
-    index++;
-    tape[index]++;
-    putchar(tape[index]);
-    tape[index] += 7;
-    putchar(tape[index]);
-    putchar(tape[index]);
-    tape[index] += 3;
-    putchar(tape[index]);
-    index++;
-    tape[index] += 2;
-    putchar(tape[index]);
-    index -= 2;
-    tape[index] += 15;
-    putchar(tape[index]);
-    index++;
-    putchar(tape[index]);
-    tape[index] += 3;
-    putchar(tape[index]);
-    tape[index] -= 6;
-    putchar(tape[index]);
-    tape[index] -= 8;
-    putchar(tape[index]);
-    index++;
-    tape[index]++;
-    putchar(tape[index]);
-    index++;
-    putchar(tape[index]);
+    tape[index] = 0;
+    tape[index+1] += 2;
+    put(tape[index+1]);
+    tape[index+2]++;
+    put(tape[index+2]);
+    tape[index+2] += 7;
+    put(tape[index+2]);
+    put(tape[index+2]);
+    tape[index+2] += 3;
+    put(tape[index+2]);
+    tape[index+3] += 2;
+    put(tape[index+3]);
+    tape[index+1] += 15;
+    put(tape[index+1]);
+    put(tape[index+2]);
+    tape[index+2] += 3;
+    put(tape[index+2]);
+    tape[index+2] -= 6;
+    put(tape[index+2]);
+    tape[index+2] -= 8;
+    put(tape[index+2]);
+    tape[index+3]++;
+    put(tape[index+3]);
+    put(tape[index+4]);
+    index += 4;
     // END
+    out_flush();
     return 0;
 }
\ No newline at end of file
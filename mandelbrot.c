@@ -1,630 +1,651 @@
 // <Autogenerated>
 #include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <errno.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 typedef unsigned char byte;
 
-byte tape[30000] = {0};
+/*
+ * what . prints is collected in `out` and written with write(2). BF_FLUSH picks when:
+ * full (when the buffer fills), line (after every newline) or read (before every ,).
+ * it is line on a terminal and full otherwise, reads from a terminal always flush first.
+ * , reads stdin a block at a time into `in`, BF_EOF picks what it stores at the end of
+ * the input: unchanged, 0 or 255.
+ */
+byte out[1 << 16], in[1 << 16];
+long long out_length, in_length, in_pos;
+char out_policy, out_interactive, in_eof = '2';
+
+void out_init(void)
+{
+    out_policy = isatty(STDOUT_FILENO) ? 'l' : 'f';
+    if (getenv("BF_FLUSH") != NULL) out_policy = getenv("BF_FLUSH")[0];
+    out_interactive = isatty(STDIN_FILENO);
+    if (getenv("BF_EOF") != NULL) in_eof = getenv("BF_EOF")[0];
+}
+
+void out_flush(void)
+{
+    for (byte *data = out; out_length > 0; )
+    {
+        ssize_t written = write(STDOUT_FILENO, data, out_length);
+
+        if (written < 0 && errno == EINTR) continue;
+        if (written < 0) break;
+
+        data += written;
+        out_length -= written;
+    }
+
+    out_length = 0;
+}
+
+void put(byte c)
+{
+    out[out_length++] = c;
+    if (out_length == sizeof(out) || (c == '\n' && out_policy == 'l')) out_flush();
+}
+
+byte get(byte cell)
+{
+    if (out_policy == 'r' || out_interactive) out_flush();
+    if (in_pos < in_length) return in[in_pos++];
+
+    do in_length = read(STDIN_FILENO, in, sizeof(in));
+    while (in_length < 0 && errno == EINTR);
+
+    in_pos = 0;
+    if (in_length > 0) return in[in_pos++];
+
+    in_length = 0;
+    return (in_eof == 'u') ? cell : (in_eof == '0') ? 0 : 255;
+}
+
+/*
+ * the tape is reserved up front and committed as the program walks into it,
+ * guard regions on both ends stop it from running off. BF_TAPE_SIZE sets how many
+ * cells it can grow to.
+ */
+byte *tape, *tape_base;
+long long tape_committed, tape_limit = 1ll << 28, tape_page, tape_guard = 1ll << 30;
+
+void tape_fault(int sig, siginfo_t *info, void *context)
+{
+    (void) context;
+    byte *addr = info->si_addr;
+
+    if (addr >= tape + tape_committed && addr < tape + tape_limit)
+    {
+        long long want = (addr - tape + 1 > 2 * tape_committed) ? addr - tape + 1 : 2 * tape_committed;
+        want = (want + tape_page - 1) / tape_page * tape_page;
+        if (want > tape_limit) want = tape_limit;
+
+        if (mprotect(tape + tape_committed, want - tape_committed, PROT_READ | PROT_WRITE) == 0)
+        {
+            tape_committed = want;
+            return;
+        }
+    }
+
+    if (addr >= tape_base && addr < tape + tape_limit + tape_guard)
+    {
+        static const char message[] = "Error: pointer moved off the tape.\n";
+
+        out_flush();
+        write(STDOUT_FILENO, message, sizeof(message) - 1);
+        _exit(4);
+    }
+
+    signal(sig, SIG_DFL);
+}
+
+void tape_init(void)
+{
+    // a tape of no cells can't run anything, so only a whole number above 0 will do
+    const char *size = getenv("BF_TAPE_SIZE");
+    if (size != NULL)
+    {
+        char *end;
+        errno = 0;
+        tape_limit = strtoll(size, &end, 10);
+        if (end == size || *end != '\0' || errno != 0 || tape_limit <= 0)
+        {
+            printf("Error: bad value for BF_TAPE_SIZE [%s].\n", size);
+            exit(1);
+        }
+    }
+
+    tape_page = sysconf(_SC_PAGESIZE);
+    tape_limit = (tape_limit + tape_page - 1) / tape_page * tape_page;
+    tape_committed = (tape_limit < (1 << 16)) ? tape_limit : (1 << 16);
+
+    // guard, the cells, guard
+    tape_base = mmap(NULL, tape_limit + 2 * tape_guard, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (tape_base == MAP_FAILED) exit(2);
+
+    tape = tape_base + tape_guard;
+    if (mprotect(tape, tape_committed, PROT_READ | PROT_WRITE) != 0) exit(2);
+
+    stack_t stack = {.ss_sp = malloc(SIGSTKSZ), .ss_size = SIGSTKSZ, .ss_flags = 0};
+    sigaltstack(&stack, NULL);
+
+    struct sigaction action = {0};
+    action.sa_sigaction = tape_fault;
+    action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+    sigaction(SIGSEGV, &action, NULL);
+}
+
+#ifdef __SSE2__
+// bit k is set when cells[k] == 0
+unsigned long long zero_mask(const byte *cells)
+{
+    unsigned long long mask = 0;
+
+    for (int k = 0; k < 4; k++)
+        mask |= (unsigned long long) (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (cells + 16 * k)), _mm_setzero_si128())) << (16 * k);
+
+    return mask;
+}
+#endif
+
+// searches what is committed, reading the next cell then grows the tape
+long long scan_right(long long index, long long stride)
+{
+    for (int k = 0; k < 8; k++, index += stride)
+        if (tape[index] == 0) return index;
+
+    unsigned long long lanes = 0;
+    long long window = 0;
+
+    while (tape[index])
+    {
+        if (stride == 1)
+        {
+            byte *zero = memchr(tape + index, 0, tape_committed - index);
+            if (zero != NULL) return zero - tape;
+            index = tape_committed;
+            continue;
+        }
+
+#ifdef __SSE2__
+        if (lanes == 0) for (window = 0; window < 64; window += stride) lanes |= 1ull << window;
+
+        for (; stride < 64 && index + 64 <= tape_committed; index += window)
+        {
+            unsigned long long hits = zero_mask(tape + index) & lanes;
+            if (hits) return index + __builtin_ctzll(hits);
+        }
+#endif
+
+        while (index < tape_committed && tape[index]) index += stride;
+        if (index < tape_committed) return index;
+    }
+
+    return index;
+}
+
+long long scan_left(long long index, long long stride)
+{
+    for (int k = 0; k < 8; k++, index -= stride)
+        if (tape[index] == 0) return index;
+
+#ifdef __SSE2__
+    if (stride < 64 && index >= 63)
+    {
+        unsigned long long lanes = 0;
+        long long window;
+
+        for (window = 0; window < 64; window += stride) lanes |= 1ull << (63 - window);
+
+        for (; index >= 63; index -= window)
+        {
+            unsigned long long hits = zero_mask(tape + index - 63) & lanes;
+            if (hits) return index - __builtin_clzll(hits);
+        }
+    }
+#endif
+
+    while (tape[index]) index -= stride;
+    return index;
+}
 
 int main(void)
 {
-    int index = 0;
+    long long index = 0;
+    out_init();
+    tape_init();
     // START
         tape[index] += 13;
-    while(tape[index]) {
-        tape[index]--;
-        index++;
-        tape[index] += 2;
-        index += 3;
-        tape[index] += 5;
-        index++;
-        tape[index] += 2;
-        index++;
-        tape[index]++;
-        index -= 6;
+    if (tape[index] != 0)
+    {
+        tape[index+1] += tape[index]*2;
+        tape[index+4] += tape[index]*5;
+        tape[index+5] += tape[index]*2;
+        tape[index+6] += tape[index];
     }
-    index += 5;
-    tape[index] += 6;
-    index++;
-    tape[index] -= 3;
-    index += 10;
-    tape[index] += 15;
+    tape[index] = 0;
+    tape[index+5] += 6;
+    tape[index+6] -= 3;
+    tape[index+16] += 15;
+    index += 16;
     while(tape[index]) {
-        while(tape[index]) {
-            index += 9;
-        }
+        index = scan_right(index, 9);
         tape[index]++;
-        while(tape[index]) {
-            index -= 9;
-        }
+        index = scan_left(index, 9);
+        tape[index+9]--;
         index += 9;
-        tape[index]--;
     }
     tape[index]++;
     while(tape[index]) {
-        index += 8;
-        while(tape[index]) {
-            tape[index]--;
-        }
-        index++;
+        tape[index+8] = 0;
+        index += 9;
     }
     index -= 9;
-    while(tape[index]) {
-        index -= 9;
-    }
-    index += 8;
-    while(tape[index]) {
-        tape[index]--;
-    }
-    tape[index]++;
-    index -= 7;
-    tape[index] += 5;
+    index = scan_left(index, 9);
+    tape[index+8] = 1;
+    tape[index+1] += 5;
+    index++;
     while(tape[index]) {
         tape[index]--;
-        while(tape[index]) {
-            tape[index]--;
-            index += 9;
-            tape[index]++;
-            index -= 9;
+        if (tape[index] != 0)
+        {
+            tape[index+9] += tape[index];
         }
+        tape[index] = 0;
         index += 9;
     }
-    index += 7;
-    tape[index]++;
-    index += 27;
-    tape[index]++;
-    index -= 17;
-    while(tape[index]) {
-        index -= 9;
-    }
+    tape[index+7]++;
+    tape[index+34]++;
+    index += 17;
+    index = scan_left(index, 9);
+    tape[index+3] = 1;
     index += 3;
-    while(tape[index]) {
-        tape[index]--;
-    }
-    tape[index]++;
     while(tape[index]) {
         index += 6;
         while(tape[index]) {
-            index += 7;
-            while(tape[index]) {
-                tape[index]--;
-            }
-            index += 2;
+            tape[index+7] = 0;
+            index += 9;
         }
         index -= 9;
-        while(tape[index]) {
-            index -= 9;
-        }
-        index += 7;
-        while(tape[index]) {
-            tape[index]--;
-        }
-        tape[index]++;
-        index -= 6;
-        tape[index] += 4;
+        index = scan_left(index, 9);
+        tape[index+7] = 1;
+        tape[index+1] += 4;
+        index++;
         while(tape[index]) {
             tape[index]--;
-            while(tape[index]) {
-                tape[index]--;
-                index += 9;
-                tape[index]++;
-                index -= 9;
+            if (tape[index] != 0)
+            {
+                tape[index+9] += tape[index];
             }
+            tape[index] = 0;
             index += 9;
         }
-        index += 6;
-        tape[index]++;
-        index -= 6;
+        tape[index+6]++;
         tape[index] += 7;
         while(tape[index]) {
             tape[index]--;
-            while(tape[index]) {
-                tape[index]--;
-                index += 9;
-                tape[index]++;
-                index -= 9;
+            if (tape[index] != 0)
+            {
+                tape[index+9] += tape[index];
             }
+            tape[index] = 0;
             index += 9;
         }
-        index += 6;
-        tape[index]++;
-        index -= 16;
-        while(tape[index]) {
-            index -= 9;
-        }
+        tape[index+6]++;
+        index -= 10;
+        index = scan_left(index, 9);
         index += 3;
         while(tape[index]) {
-            while(tape[index]) {
-                tape[index]--;
-            }
+            tape[index] = 0;
             index += 6;
             while(tape[index]) {
                 index += 7;
-                while(tape[index]) {
-                    tape[index]--;
-                    index -= 6;
-                    tape[index]++;
-                    index += 6;
+                if (tape[index] != 0)
+                {
+                    tape[index-6] += tape[index];
                 }
+                tape[index] = 0;
                 index -= 6;
-                while(tape[index]) {
-                    tape[index]--;
-                    index += 6;
-                    tape[index]++;
-                    index -= 2;
-                    tape[index]++;
-                    index -= 3;
-                    tape[index]++;
-                    index--;
+                if (tape[index] != 0)
+                {
+                    tape[index+6] += tape[index];
+                    tape[index+4] += tape[index];
+                    tape[index+1] += tape[index];
                 }
+                tape[index] = 0;
                 index += 8;
             }
             index -= 9;
-            while(tape[index]) {
-                index -= 9;
-            }
+            index = scan_left(index, 9);
             index += 9;
             while(tape[index]) {
                 index += 8;
-                while(tape[index]) {
-                    tape[index]--;
-                    index -= 7;
-                    tape[index]++;
-                    index += 7;
+                if (tape[index] != 0)
+                {
+                    tape[index-7] += tape[index];
                 }
+                tape[index] = 0;
                 index -= 7;
-                while(tape[index]) {
-                    tape[index]--;
-                    index += 7;
-                    tape[index]++;
-                    index -= 2;
-                    tape[index]++;
-                    index -= 3;
-                    tape[index]++;
-                    index -= 2;
+                if (tape[index] != 0)
+                {
+                    tape[index+7] += tape[index];
+                    tape[index+5] += tape[index];
+                    tape[index+2] += tape[index];
                 }
+                tape[index] = 0;
                 index += 8;
             }
             index -= 9;
-            while(tape[index]) {
-                index -= 9;
-            }
+            index = scan_left(index, 9);
             index += 7;
-            while(tape[index]) {
-                tape[index]--;
-                index -= 7;
-                tape[index]++;
-                index += 7;
+            if (tape[index] != 0)
+            {
+                tape[index-7] += tape[index];
             }
+            tape[index] = 0;
             index -= 7;
-            while(tape[index]) {
-                tape[index]--;
-                index += 7;
-                tape[index]++;
-                index -= 2;
-                tape[index]++;
-                index -= 5;
+            if (tape[index] != 0)
+            {
+                tape[index+7] += tape[index];
+                tape[index+5] += tape[index];
             }
+            tape[index] = 0;
+            tape[index+9] += 15;
             index += 9;
-            tape[index] += 15;
             while(tape[index]) {
-                while(tape[index]) {
-                    index += 9;
-                }
+                index = scan_right(index, 9);
                 tape[index]++;
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
+                tape[index+1] = 0;
+                tape[index+2] = 0;
+                tape[index+3] = 0;
+                tape[index+4] = 0;
+                tape[index+5] = 0;
+                tape[index+6] = 0;
+                tape[index+7] = 0;
+                tape[index+8] = 0;
+                tape[index+9] = 0;
+                index = scan_left(index, 9);
+                tape[index+9]--;
                 index += 9;
-                tape[index]--;
             }
             tape[index]++;
             while(tape[index]) {
-                index++;
-                tape[index]++;
-                index += 8;
+                tape[index+1]++;
+                index += 9;
             }
             index -= 9;
-            while(tape[index]) {
-                index -= 9;
-            }
+            index = scan_left(index, 9);
             index += 9;
             while(tape[index]) {
-                index++;
-                tape[index]--;
-                index += 4;
-                while(tape[index]) {
-                    tape[index]--;
-                    index -= 4;
-                    tape[index]++;
-                    index += 4;
+                tape[index+1]--;
+                index += 5;
+                if (tape[index] != 0)
+                {
+                    tape[index-4] += tape[index];
                 }
+                tape[index] = 0;
                 index -= 4;
                 while(tape[index]) {
                     tape[index]--;
-                    index += 4;
-                    tape[index]++;
-                    index -= 5;
+                    tape[index+4]++;
+                    index--;
                     while(tape[index]) {
                         tape[index]--;
                         index += 2;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index -= 2;
-                            tape[index]++;
-                            index += 2;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-2] += tape[index];
                         }
+                        tape[index] = 0;
                         index -= 2;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index += 2;
-                            tape[index]++;
-                            index += 2;
-                            tape[index]++;
-                            index -= 4;
+                        if (tape[index] != 0)
+                        {
+                            tape[index+2] += tape[index];
+                            tape[index+4] += tape[index];
                         }
-                        tape[index]++;
+                        tape[index] = 1;
                         index += 9;
                     }
                     index -= 8;
-                    while(tape[index]) {
-                        index -= 9;
-                    }
+                    index = scan_left(index, 9);
                 }
                 index += 9;
-                while(tape[index]) {
-                    index += 9;
-                }
+                index = scan_right(index, 9);
                 index -= 9;
                 while(tape[index]) {
                     index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 9;
-                        tape[index]++;
-                        index -= 9;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+9] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 10;
                 }
                 index++;
-                while(tape[index]) {
-                    tape[index]--;
-                    index += 9;
-                    tape[index]++;
-                    index -= 9;
+                if (tape[index] != 0)
+                {
+                    tape[index+9] += tape[index];
                 }
-                index--;
-                tape[index]++;
-                index += 8;
+                tape[index] = 0;
+                tape[index-1]++;
+                index += 7;
             }
             index -= 9;
             while(tape[index]) {
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index--;
+                tape[index+1] = 0;
                 tape[index]--;
                 index += 4;
                 while(tape[index]) {
                     tape[index]--;
-                    index -= 4;
-                    tape[index]++;
-                    index++;
-                    while(tape[index]) {
-                        index--;
-                        tape[index]--;
-                        index++;
-                        tape[index]--;
-                        index -= 6;
-                        tape[index]++;
-                        index += 6;
+                    tape[index-4]++;
+                    index -= 3;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-1] -= tape[index];
+                        tape[index-6] += tape[index];
                     }
+                    tape[index] = 0;
                     index--;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index++;
-                        tape[index]++;
-                        index--;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+1] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 4;
                 }
                 index -= 3;
-                while(tape[index]) {
-                    tape[index]--;
-                    index += 3;
-                    tape[index]++;
-                    index -= 3;
+                if (tape[index] != 0)
+                {
+                    tape[index+3] += tape[index];
                 }
-                index--;
-                tape[index]++;
-                index -= 9;
+                tape[index] = 0;
+                tape[index-1]++;
+                index -= 10;
             }
             index += 9;
             while(tape[index]) {
-                index++;
-                tape[index]++;
-                index += 8;
+                tape[index+1]++;
+                index += 9;
             }
             index -= 9;
-            while(tape[index]) {
-                index -= 9;
-            }
+            index = scan_left(index, 9);
             index += 9;
             while(tape[index]) {
-                index++;
-                tape[index]--;
-                index += 5;
-                while(tape[index]) {
-                    tape[index]--;
-                    index -= 5;
-                    tape[index]++;
-                    index += 5;
+                tape[index+1]--;
+                index += 6;
+                if (tape[index] != 0)
+                {
+                    tape[index-5] += tape[index];
                 }
+                tape[index] = 0;
                 index -= 5;
                 while(tape[index]) {
                     tape[index]--;
-                    index += 5;
-                    tape[index]++;
-                    index -= 6;
+                    tape[index+5]++;
+                    index--;
                     while(tape[index]) {
                         tape[index]--;
                         index += 3;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index -= 3;
-                            tape[index]++;
-                            index += 3;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-3] += tape[index];
                         }
+                        tape[index] = 0;
                         index -= 3;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index += 3;
-                            tape[index]++;
-                            index++;
-                            tape[index]++;
-                            index -= 4;
+                        if (tape[index] != 0)
+                        {
+                            tape[index+3] += tape[index];
+                            tape[index+4] += tape[index];
                         }
-                        tape[index]++;
+                        tape[index] = 1;
                         index += 9;
                     }
                     index -= 8;
-                    while(tape[index]) {
-                        index -= 9;
-                    }
+                    index = scan_left(index, 9);
                 }
                 index += 9;
-                while(tape[index]) {
-                    index += 9;
-                }
+                index = scan_right(index, 9);
                 index -= 9;
                 while(tape[index]) {
                     index += 2;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 9;
-                        tape[index]++;
-                        index -= 9;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+9] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 11;
                 }
                 index += 2;
-                while(tape[index]) {
-                    tape[index]--;
-                    index += 9;
-                    tape[index]++;
-                    index -= 9;
+                if (tape[index] != 0)
+                {
+                    tape[index+9] += tape[index];
                 }
-                index -= 2;
-                tape[index]++;
-                index += 8;
+                tape[index] = 0;
+                tape[index-2]++;
+                index += 6;
             }
             index -= 9;
             while(tape[index]) {
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index--;
+                tape[index+1] = 0;
                 tape[index]--;
                 index += 4;
                 while(tape[index]) {
                     tape[index]--;
-                    index -= 4;
-                    tape[index]++;
-                    index++;
-                    while(tape[index]) {
-                        index--;
-                        tape[index]--;
-                        index++;
-                        tape[index]--;
-                        index -= 6;
-                        tape[index]++;
-                        index += 6;
+                    tape[index-4]++;
+                    index -= 3;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-1] -= tape[index];
+                        tape[index-6] += tape[index];
                     }
+                    tape[index] = 0;
                     index--;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index++;
-                        tape[index]++;
-                        index--;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+1] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 4;
                 }
                 index -= 3;
-                while(tape[index]) {
-                    tape[index]--;
-                    index += 3;
-                    tape[index]++;
-                    index -= 3;
+                if (tape[index] != 0)
+                {
+                    tape[index+3] += tape[index];
                 }
-                index--;
-                tape[index]++;
-                index -= 9;
+                tape[index] = 0;
+                tape[index-1]++;
+                index -= 10;
             }
             index += 9;
             while(tape[index]) {
                 index += 4;
-                while(tape[index]) {
-                    tape[index]--;
-                    index -= 36;
-                    tape[index]++;
-                    index += 36;
+                if (tape[index] != 0)
+                {
+                    tape[index-36] += tape[index];
                 }
-                index += 5;
-            }
-            index -= 9;
-            while(tape[index]) {
-                index -= 9;
-            }
-            index += 9;
-            tape[index] += 15;
-            while(tape[index]) {
-                while(tape[index]) {
-                    index += 9;
-                }
-                index -= 9;
-                tape[index]--;
-                index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
-                index += 9;
-                tape[index]--;
+                tape[index] = 0;
+                index += 5;
             }
-            tape[index]++;
-            index += 21;
-            tape[index]++;
-            index -= 3;
+            index -= 9;
+            index = scan_left(index, 9);
+            tape[index+9] += 15;
+            index += 9;
             while(tape[index]) {
-                index -= 9;
+                index = scan_right(index, 9);
+                tape[index-9]--;
+                index -= 18;
+                index = scan_left(index, 9);
+                tape[index+9]--;
+                index += 9;
             }
+            tape[index]++;
+            tape[index+21]++;
+            index += 18;
+            index = scan_left(index, 9);
             index += 9;
             while(tape[index]) {
                 index += 3;
-                while(tape[index]) {
-                    tape[index]--;
-                    index -= 3;
-                    tape[index]--;
-                    index += 3;
+                if (tape[index] != 0)
+                {
+                    tape[index-3] -= tape[index];
                 }
-                tape[index]++;
+                tape[index] = 1;
                 index -= 3;
                 while(tape[index]) {
                     tape[index]--;
-                    index += 3;
-                    tape[index]--;
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 4;
-                        tape[index]++;
-                        index += 4;
+                    tape[index+3]--;
+                    index += 4;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-4] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 4;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 4;
-                        tape[index]++;
-                        index -= 13;
-                        while(tape[index]) {
-                            index -= 9;
-                        }
-                        index += 4;
-                        while(tape[index]) {
-                            tape[index]--;
-                        }
-                        tape[index]++;
-                        index += 5;
-                        while(tape[index]) {
-                            index += 9;
-                        }
-                        index++;
-                        tape[index]++;
-                        index--;
+                        tape[index+4]++;
+                        index -= 9;
+                        index = scan_left(index, 9);
+                        tape[index+4] = 1;
+                        index += 9;
+                        index = scan_right(index, 9);
+                        tape[index+1]++;
                     }
                 }
                 tape[index]++;
                 index += 4;
-                while(tape[index]) {
-                    tape[index]--;
-                    index -= 4;
-                    tape[index]--;
-                    index += 4;
+                if (tape[index] != 0)
+                {
+                    tape[index-4] -= tape[index];
                 }
-                tape[index]++;
+                tape[index] = 1;
                 index -= 4;
                 while(tape[index]) {
                     tape[index]--;
-                    index += 4;
-                    tape[index]--;
-                    index--;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 3;
-                        tape[index]++;
-                        index += 3;
+                    tape[index+4]--;
+                    index += 3;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-3] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 3;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 3;
-                        tape[index]++;
-                        index -= 12;
-                        while(tape[index]) {
-                            index -= 9;
-                        }
-                        index += 3;
-                        while(tape[index]) {
-                            tape[index]--;
-                        }
-                        tape[index]++;
-                        index += 6;
-                        while(tape[index]) {
-                            index += 9;
-                        }
-                        index++;
-                        while(tape[index]) {
-                            tape[index]--;
-                        }
-                        tape[index]++;
-                        index--;
+                        tape[index+3]++;
+                        index -= 9;
+                        index = scan_left(index, 9);
+                        tape[index+3] = 1;
+                        index += 9;
+                        index = scan_right(index, 9);
+                        tape[index+1] = 1;
                     }
                 }
                 tape[index]++;
@@ -632,697 +653,491 @@ int main(void)
                 while(tape[index]) {
                     tape[index]--;
                     index--;
-                    while(tape[index]) {
-                        index += 9;
-                    }
+                    index = scan_right(index, 9);
                     index -= 8;
                 }
                 index += 8;
             }
             index -= 9;
-            while(tape[index]) {
-                index -= 9;
-            }
+            index = scan_left(index, 9);
             index -= 7;
-            while(tape[index]) {
-                tape[index]--;
-                index++;
-                tape[index]++;
-                index += 3;
-                tape[index]--;
-                index -= 4;
-            }
-            index += 9;
-            tape[index] += 26;
-            index += 2;
-            while(tape[index]) {
-                tape[index]--;
-                index -= 4;
-                tape[index]++;
-                index += 4;
-            }
+            if (tape[index] != 0)
+            {
+                tape[index+1] += tape[index];
+                tape[index+4] -= tape[index];
+            }
+            tape[index] = 0;
+            tape[index+9] += 26;
+            index += 11;
+            if (tape[index] != 0)
+            {
+                tape[index-4] += tape[index];
+            }
+            tape[index] = 0;
             index -= 4;
             while(tape[index]) {
                 tape[index]--;
-                index += 4;
-                tape[index]++;
-                index -= 2;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index -= 2;
+                tape[index+4]++;
+                tape[index+2] = 0;
             }
             index += 2;
             while(tape[index]) {
-                index -= 7;
-                tape[index]++;
-                index--;
+                tape[index-7]++;
+                index -= 8;
                 while(tape[index]) {
                     tape[index]--;
-                    index--;
-                    tape[index]++;
-                    index += 4;
-                    tape[index]++;
-                    index -= 2;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
+                    tape[index-1]++;
+                    tape[index+3]++;
+                    tape[index+1] = 0;
+                    index++;
                 }
                 index++;
                 while(tape[index]) {
                     tape[index]--;
                     index -= 2;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index++;
-                        tape[index]++;
-                        index += 3;
-                        tape[index]--;
-                        index -= 4;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+1] += tape[index];
+                        tape[index+4] -= tape[index];
                     }
+                    tape[index] = 0;
                     index += 3;
                 }
                 index += 13;
                 while(tape[index]) {
-                    index += 2;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index += 5;
+                    tape[index+2] = 0;
+                    tape[index+3] = 0;
+                    tape[index+4] = 0;
+                    index += 9;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
-                index += 3;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index += 6;
+                index = scan_left(index, 9);
+                tape[index+3] = 0;
+                index += 9;
                 while(tape[index]) {
                     index += 5;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 4;
-                        tape[index]++;
-                        index += 4;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-4] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 4;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 4;
-                        tape[index]++;
-                        index -= 3;
-                        tape[index]++;
-                        index--;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+4] += tape[index];
+                        tape[index+1] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 8;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
+                index = scan_left(index, 9);
                 index += 9;
                 while(tape[index]) {
                     index += 2;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 9;
-                        tape[index]++;
-                        index += 9;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-9] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 7;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
+                index = scan_left(index, 9);
+                tape[index+9] += 15;
                 index += 9;
-                tape[index] += 15;
                 while(tape[index]) {
-                    while(tape[index]) {
-                        index += 9;
-                    }
-                    tape[index]++;
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index -= 9;
-                    while(tape[index]) {
-                        index -= 9;
-                    }
+                    index = scan_right(index, 9);
+                    tape[index]++;
+                    tape[index+1] = 0;
+                    tape[index+2] = 0;
+                    tape[index+3] = 0;
+                    tape[index+4] = 0;
+                    tape[index+5] = 0;
+                    tape[index+6] = 0;
+                    tape[index+7] = 0;
+                    tape[index+8] = 0;
+                    tape[index+9] = 0;
+                    index = scan_left(index, 9);
+                    tape[index+9]--;
                     index += 9;
-                    tape[index]--;
                 }
                 tape[index]++;
                 while(tape[index]) {
-                    index++;
-                    tape[index]++;
-                    index += 8;
+                    tape[index+1]++;
+                    index += 9;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
+                index = scan_left(index, 9);
                 index += 9;
                 while(tape[index]) {
-                    index++;
-                    tape[index]--;
-                    index += 5;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 5;
-                        tape[index]++;
-                        index += 5;
+                    tape[index+1]--;
+                    index += 6;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-5] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 5;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 5;
-                        tape[index]++;
-                        index -= 6;
+                        tape[index+5]++;
+                        index--;
                         while(tape[index]) {
                             tape[index]--;
                             index += 2;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index -= 2;
-                                tape[index]++;
-                                index += 2;
+                            if (tape[index] != 0)
+                            {
+                                tape[index-2] += tape[index];
                             }
+                            tape[index] = 0;
                             index -= 2;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index += 2;
-                                tape[index]++;
-                                index++;
-                                tape[index]++;
-                                index -= 3;
+                            if (tape[index] != 0)
+                            {
+                                tape[index+2] += tape[index];
+                                tape[index+3] += tape[index];
                             }
-                            tape[index]++;
+                            tape[index] = 1;
                             index += 9;
                         }
-                        index -= 8;
-                        while(tape[index]) {
-                            index -= 9;
-                        }
-                    }
-                    index += 9;
-                    while(tape[index]) {
-                        index += 9;
+                        index -= 8;
+                        index = scan_left(index, 9);
                     }
+                    index += 9;
+                    index = scan_right(index, 9);
                     index -= 9;
                     while(tape[index]) {
                         index++;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index += 9;
-                            tape[index]++;
-                            index -= 9;
+                        if (tape[index] != 0)
+                        {
+                            tape[index+9] += tape[index];
                         }
+                        tape[index] = 0;
                         index -= 10;
                     }
                     index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 9;
-                        tape[index]++;
-                        index -= 9;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+9] += tape[index];
                     }
-                    index--;
-                    tape[index]++;
-                    index += 8;
+                    tape[index] = 0;
+                    tape[index-1]++;
+                    index += 7;
                 }
                 index -= 9;
                 while(tape[index]) {
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index--;
+                    tape[index+1] = 0;
                     tape[index]--;
                     index += 3;
                     while(tape[index]) {
                         tape[index]--;
-                        index -= 3;
-                        tape[index]++;
-                        index++;
-                        while(tape[index]) {
-                            index--;
-                            tape[index]--;
-                            index++;
-                            tape[index]--;
-                            index -= 7;
-                            tape[index]++;
-                            index += 7;
+                        tape[index-3]++;
+                        index -= 2;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-1] -= tape[index];
+                            tape[index-7] += tape[index];
                         }
+                        tape[index] = 0;
                         index--;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index++;
-                            tape[index]++;
-                            index--;
+                        if (tape[index] != 0)
+                        {
+                            tape[index+1] += tape[index];
                         }
+                        tape[index] = 0;
                         index += 3;
                     }
                     index -= 2;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 2;
-                        tape[index]++;
-                        index -= 2;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+2] += tape[index];
                     }
-                    index--;
-                    tape[index]++;
-                    index -= 9;
+                    tape[index] = 0;
+                    tape[index-1]++;
+                    index -= 10;
                 }
                 index += 9;
                 while(tape[index]) {
                     index += 6;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 5;
-                        tape[index]++;
-                        index += 5;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-5] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 5;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 5;
-                        tape[index]++;
-                        index -= 4;
-                        tape[index]++;
-                        index--;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+5] += tape[index];
+                        tape[index+1] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 8;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
+                index = scan_left(index, 9);
                 index += 9;
                 while(tape[index]) {
-                    index++;
-                    tape[index]++;
-                    index += 8;
+                    tape[index+1]++;
+                    index += 9;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
+                index = scan_left(index, 9);
                 index += 9;
                 while(tape[index]) {
-                    index++;
-                    tape[index]--;
-                    index += 5;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 5;
-                        tape[index]++;
-                        index += 5;
+                    tape[index+1]--;
+                    index += 6;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-5] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 5;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 5;
-                        tape[index]++;
-                        index -= 6;
+                        tape[index+5]++;
+                        index--;
                         while(tape[index]) {
                             tape[index]--;
                             index += 2;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index -= 2;
-                                tape[index]++;
-                                index += 2;
+                            if (tape[index] != 0)
+                            {
+                                tape[index-2] += tape[index];
                             }
+                            tape[index] = 0;
                             index -= 2;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index += 2;
-                                tape[index]++;
-                                index += 2;
-                                tape[index]++;
-                                index -= 4;
+                            if (tape[index] != 0)
+                            {
+                                tape[index+2] += tape[index];
+                                tape[index+4] += tape[index];
                             }
-                            tape[index]++;
+                            tape[index] = 1;
                             index += 9;
                         }
                         index -= 8;
-                        while(tape[index]) {
-                            index -= 9;
-                        }
+                        index = scan_left(index, 9);
                     }
                     index += 9;
-                    while(tape[index]) {
-                        index += 9;
-                    }
+                    index = scan_right(index, 9);
                     index -= 9;
                     while(tape[index]) {
                         index++;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index += 9;
-                            tape[index]++;
-                            index -= 9;
+                        if (tape[index] != 0)
+                        {
+                            tape[index+9] += tape[index];
                         }
+                        tape[index] = 0;
                         index -= 10;
                     }
                     index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 9;
-                        tape[index]++;
-                        index -= 9;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+9] += tape[index];
                     }
-                    index--;
-                    tape[index]++;
-                    index += 8;
+                    tape[index] = 0;
+                    tape[index-1]++;
+                    index += 7;
                 }
                 index -= 9;
                 while(tape[index]) {
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index--;
+                    tape[index+1] = 0;
                     tape[index]--;
                     index += 4;
                     while(tape[index]) {
                         tape[index]--;
-                        index -= 4;
-                        tape[index]++;
-                        index++;
-                        while(tape[index]) {
-                            index--;
-                            tape[index]--;
-                            index++;
-                            tape[index]--;
-                            index -= 6;
-                            tape[index]++;
-                            index += 6;
+                        tape[index-4]++;
+                        index -= 3;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-1] -= tape[index];
+                            tape[index-6] += tape[index];
                         }
+                        tape[index] = 0;
                         index--;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index++;
-                            tape[index]++;
-                            index--;
+                        if (tape[index] != 0)
+                        {
+                            tape[index+1] += tape[index];
                         }
+                        tape[index] = 0;
                         index += 4;
                     }
                     index -= 3;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 3;
-                        tape[index]++;
-                        index -= 3;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+3] += tape[index];
                     }
-                    index--;
-                    tape[index]++;
-                    index -= 9;
+                    tape[index] = 0;
+                    tape[index-1]++;
+                    index -= 10;
                 }
                 index += 9;
                 while(tape[index]) {
                     index += 4;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 36;
-                        tape[index]++;
-                        index += 36;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-36] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 5;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
+                index = scan_left(index, 9);
                 index += 9;
                 while(tape[index]) {
                     index += 3;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 36;
-                        tape[index]++;
-                        index += 36;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-36] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 6;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
+                index = scan_left(index, 9);
+                tape[index+9] += 15;
                 index += 9;
-                tape[index] += 15;
                 while(tape[index]) {
-                    while(tape[index]) {
-                        index += 9;
-                    }
-                    index -= 9;
-                    tape[index]--;
-                    index -= 9;
-                    while(tape[index]) {
-                        index -= 9;
-                    }
+                    index = scan_right(index, 9);
+                    tape[index-9]--;
+                    index -= 18;
+                    index = scan_left(index, 9);
+                    tape[index+9]--;
                     index += 9;
-                    tape[index]--;
                 }
                 tape[index]++;
                 while(tape[index]) {
                     index += 8;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 7;
-                        tape[index]++;
-                        index += 7;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-7] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 7;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 7;
-                        tape[index]++;
-                        index -= 6;
-                        tape[index]++;
-                        index--;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+7] += tape[index];
+                        tape[index+1] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 8;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
+                index = scan_left(index, 9);
                 index += 9;
                 while(tape[index]) {
-                    index += 6;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index += 3;
+                    tape[index+6] = 0;
+                    index += 9;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
-                index += 4;
-                tape[index]++;
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                    index--;
-                    tape[index]--;
-                    index -= 4;
-                    tape[index]++;
-                    index += 5;
+                index = scan_left(index, 9);
+                tape[index+4]++;
+                index += 5;
+                if (tape[index] != 0)
+                {
+                    tape[index-1] -= tape[index];
+                    tape[index-5] += tape[index];
                 }
+                tape[index] = 0;
                 index++;
                 while(tape[index]) {
                     tape[index]--;
                     index -= 6;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 5;
-                        tape[index]++;
-                        index--;
-                        tape[index] += 2;
-                        index -= 4;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+5] += tape[index];
+                        tape[index+4] += tape[index]*2;
                     }
+                    tape[index] = 0;
                     index += 5;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 5;
-                        tape[index]++;
-                        index += 5;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-5] += tape[index];
                     }
-                    index--;
-                    tape[index]--;
-                    index++;
+                    tape[index] = 0;
+                    tape[index-1]--;
                     tape[index]++;
                     index++;
                 }
                 index--;
-                while(tape[index]) {
-                    tape[index]--;
-                    index++;
-                    tape[index]++;
-                    index--;
+                if (tape[index] != 0)
+                {
+                    tape[index+1] += tape[index];
                 }
+                tape[index] = 0;
                 index -= 5;
-                while(tape[index]) {
-                    tape[index]--;
-                    index += 5;
-                    tape[index]++;
-                    index -= 5;
-                }
-                index += 6;
-                while(tape[index]) {
-                    tape[index]--;
+                if (tape[index] != 0)
+                {
+                    tape[index+5] += tape[index];
                 }
-                index -= 6;
+                tape[index] = 0;
+                tape[index+6] = 0;
                 tape[index]++;
                 index += 4;
-                while(tape[index]) {
-                    tape[index]--;
-                    index -= 4;
-                    tape[index]--;
-                    index += 4;
+                if (tape[index] != 0)
+                {
+                    tape[index-4] -= tape[index];
                 }
-                tape[index]++;
+                tape[index] = 1;
                 index -= 4;
                 while(tape[index]) {
                     tape[index]--;
-                    index += 4;
-                    tape[index]--;
-                    index += 5;
+                    tape[index+4]--;
+                    index += 9;
                     while(tape[index]) {
                         index += 2;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index -= 2;
-                            tape[index]--;
-                            index += 2;
-                        }
-                        tape[index]++;
-                        index -= 2;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index += 2;
-                            tape[index]--;
-                            index++;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index -= 3;
-                                tape[index]++;
-                                index += 3;
-                            }
-                            index -= 3;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index += 3;
-                                tape[index]++;
-                                index -= 12;
-                                while(tape[index]) {
-                                    index -= 9;
-                                }
-                                index += 3;
-                                while(tape[index]) {
-                                    tape[index]--;
-                                }
-                                tape[index]++;
-                                index += 6;
-                                while(tape[index]) {
-                                    index += 9;
-                                }
-                                index++;
-                                tape[index]++;
-                                index--;
-                            }
+                        if (tape[index] != 0)
+                        {
+                            tape[index-2] -= tape[index];
                         }
-                        tape[index]++;
-                        index += 3;
+                        tape[index] = 1;
+                        index -= 2;
                         while(tape[index]) {
                             tape[index]--;
-                            index -= 3;
-                            tape[index]--;
+                            tape[index+2]--;
                             index += 3;
+                            if (tape[index] != 0)
+                            {
+                                tape[index-3] += tape[index];
+                            }
+                            tape[index] = 0;
+                            index -= 3;
+                            while(tape[index]) {
+                                tape[index]--;
+                                tape[index+3]++;
+                                index -= 9;
+                                index = scan_left(index, 9);
+                                tape[index+3] = 1;
+                                index += 9;
+                                index = scan_right(index, 9);
+                                tape[index+1]++;
+                            }
                         }
                         tape[index]++;
+                        index += 3;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-3] -= tape[index];
+                        }
+                        tape[index] = 1;
                         index -= 3;
                         while(tape[index]) {
                             tape[index]--;
-                            index += 3;
-                            tape[index]--;
-                            index--;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index -= 2;
-                                tape[index]++;
-                                index += 2;
+                            tape[index+3]--;
+                            index += 2;
+                            if (tape[index] != 0)
+                            {
+                                tape[index-2] += tape[index];
                             }
+                            tape[index] = 0;
                             index -= 2;
                             while(tape[index]) {
                                 tape[index]--;
-                                index += 2;
-                                tape[index]++;
-                                index -= 11;
-                                while(tape[index]) {
-                                    index -= 9;
-                                }
-                                index += 4;
-                                while(tape[index]) {
-                                    tape[index]--;
-                                }
-                                tape[index]++;
-                                index += 5;
-                                while(tape[index]) {
-                                    index += 9;
-                                }
-                                index++;
-                                while(tape[index]) {
-                                    tape[index]--;
-                                }
-                                tape[index]++;
-                                index--;
+                                tape[index+2]++;
+                                index -= 9;
+                                index = scan_left(index, 9);
+                                tape[index+4] = 1;
+                                index += 9;
+                                index = scan_right(index, 9);
+                                tape[index+1] = 1;
                             }
                         }
                         tape[index]++;
@@ -1330,638 +1145,456 @@ int main(void)
                         while(tape[index]) {
                             tape[index]--;
                             index--;
-                            while(tape[index]) {
-                                index += 9;
-                            }
+                            index = scan_right(index, 9);
                             index -= 8;
                         }
                         index += 8;
                     }
                     index -= 9;
-                    while(tape[index]) {
-                        index -= 9;
-                    }
+                    index = scan_left(index, 9);
                     index += 4;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 4;
-                        tape[index]++;
-                        index += 4;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-4] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 4;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 4;
-                        tape[index]++;
-                        index += 5;
+                        tape[index+4]++;
+                        index += 9;
                         while(tape[index]) {
-                            index++;
-                            tape[index]++;
-                            index += 2;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index -= 2;
-                                tape[index]--;
-                                index += 2;
+                            tape[index+1]++;
+                            index += 3;
+                            if (tape[index] != 0)
+                            {
+                                tape[index-2] -= tape[index];
                             }
+                            tape[index] = 0;
                             index -= 2;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index += 2;
-                                tape[index]++;
-                                index -= 2;
+                            if (tape[index] != 0)
+                            {
+                                tape[index+2] += tape[index];
                             }
+                            tape[index] = 0;
                             index += 8;
                         }
-                        index -= 8;
-                        tape[index]++;
-                        index--;
+                        tape[index-8]++;
+                        index -= 9;
                         while(tape[index]) {
                             index++;
                             while(tape[index]) {
                                 tape[index]--;
-                                index += 5;
-                                tape[index]++;
-                                index -= 4;
+                                tape[index+5]++;
+                                index++;
                                 while(tape[index]) {
                                     tape[index]--;
-                                    index += 4;
-                                    tape[index]--;
-                                    index -= 14;
-                                    tape[index]++;
-                                    index += 11;
-                                    while(tape[index]) {
-                                        tape[index]--;
-                                        index += 3;
-                                        tape[index]++;
-                                        index -= 3;
+                                    tape[index+4]--;
+                                    tape[index-10]++;
+                                    index++;
+                                    if (tape[index] != 0)
+                                    {
+                                        tape[index+3] += tape[index];
                                     }
+                                    tape[index] = 0;
                                     index--;
                                 }
                                 index++;
-                                while(tape[index]) {
-                                    tape[index]--;
-                                    index += 3;
-                                    tape[index]--;
-                                    index -= 14;
-                                    tape[index]++;
-                                    index += 11;
+                                if (tape[index] != 0)
+                                {
+                                    tape[index+3] -= tape[index];
+                                    tape[index-11] += tape[index];
                                 }
+                                tape[index] = 0;
                                 index -= 2;
                             }
                             index++;
                             while(tape[index]) {
                                 tape[index]--;
-                                index += 4;
-                                tape[index]++;
-                                index -= 3;
-                                while(tape[index]) {
-                                    tape[index]--;
-                                    index += 3;
-                                    tape[index]--;
-                                    index -= 14;
-                                    tape[index]++;
-                                    index += 11;
+                                tape[index+4]++;
+                                index++;
+                                if (tape[index] != 0)
+                                {
+                                    tape[index+3] -= tape[index];
+                                    tape[index-11] += tape[index];
                                 }
+                                tape[index] = 0;
                                 index--;
                             }
                             index++;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index += 3;
-                                tape[index]++;
-                                index -= 3;
+                            if (tape[index] != 0)
+                            {
+                                tape[index+3] += tape[index];
                             }
+                            tape[index] = 0;
                             index -= 12;
                         }
-                        index += 4;
-                        while(tape[index]) {
-                            tape[index]--;
-                        }
-                        index -= 4;
+                        tape[index+4] = 0;
                     }
                     index += 3;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 3;
-                        tape[index]++;
-                        index += 3;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-3] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 3;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 3;
-                        tape[index]++;
-                        index += 6;
+                        tape[index+3]++;
+                        index += 9;
                         while(tape[index]) {
-                            index++;
-                            tape[index]++;
-                            index++;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index--;
-                                tape[index]--;
-                                index++;
+                            tape[index+1]++;
+                            index += 2;
+                            if (tape[index] != 0)
+                            {
+                                tape[index-1] -= tape[index];
                             }
+                            tape[index] = 0;
                             index--;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index++;
-                                tape[index]++;
-                                index--;
+                            if (tape[index] != 0)
+                            {
+                                tape[index+1] += tape[index];
                             }
+                            tape[index] = 0;
                             index += 8;
                         }
-                        index -= 8;
-                        tape[index]++;
-                        index--;
+                        tape[index-8]++;
+                        index -= 9;
                         while(tape[index]) {
                             index++;
                             while(tape[index]) {
                                 tape[index]--;
-                                index += 5;
-                                tape[index]++;
-                                index -= 3;
+                                tape[index+5]++;
+                                index += 2;
                                 while(tape[index]) {
                                     tape[index]--;
-                                    index += 3;
-                                    tape[index]--;
-                                    index -= 14;
-                                    tape[index]++;
-                                    index += 10;
-                                    while(tape[index]) {
-                                        tape[index]--;
-                                        index += 4;
-                                        tape[index]++;
-                                        index -= 4;
+                                    tape[index+3]--;
+                                    tape[index-11]++;
+                                    index--;
+                                    if (tape[index] != 0)
+                                    {
+                                        tape[index+4] += tape[index];
                                     }
+                                    tape[index] = 0;
                                     index++;
                                 }
                                 index--;
-                                while(tape[index]) {
-                                    tape[index]--;
-                                    index += 4;
-                                    tape[index]--;
-                                    index -= 14;
-                                    tape[index]++;
-                                    index += 10;
+                                if (tape[index] != 0)
+                                {
+                                    tape[index+4] -= tape[index];
+                                    tape[index-10] += tape[index];
                                 }
+                                tape[index] = 0;
                                 index--;
                             }
                             index += 2;
                             while(tape[index]) {
                                 tape[index]--;
-                                index += 3;
-                                tape[index]++;
-                                index -= 4;
-                                while(tape[index]) {
-                                    tape[index]--;
-                                    index += 4;
-                                    tape[index]--;
-                                    index -= 14;
-                                    tape[index]++;
-                                    index += 10;
+                                tape[index+3]++;
+                                index--;
+                                if (tape[index] != 0)
+                                {
+                                    tape[index+4] -= tape[index];
+                                    tape[index-10] += tape[index];
                                 }
+                                tape[index] = 0;
                                 index++;
                             }
                             index--;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index += 4;
-                                tape[index]++;
-                                index -= 4;
+                            if (tape[index] != 0)
+                            {
+                                tape[index+4] += tape[index];
                             }
+                            tape[index] = 0;
                             index -= 11;
                         }
-                        index += 6;
-                        tape[index]++;
-                        index -= 6;
+                        tape[index+6]++;
                     }
                 }
                 index += 4;
-                while(tape[index]) {
-                    tape[index]--;
-                    index -= 4;
-                    tape[index]++;
-                    index += 4;
+                if (tape[index] != 0)
+                {
+                    tape[index-4] += tape[index];
                 }
+                tape[index] = 0;
                 index -= 4;
                 while(tape[index]) {
                     tape[index]--;
-                    index += 4;
-                    tape[index]++;
-                    index += 5;
-                    while(tape[index]) {
-                        index += 9;
-                    }
+                    tape[index+4]++;
+                    index += 9;
+                    index = scan_right(index, 9);
                     index -= 9;
                     while(tape[index]) {
                         index++;
                         while(tape[index]) {
                             tape[index]--;
-                            index += 5;
-                            tape[index]++;
-                            index -= 4;
+                            tape[index+5]++;
+                            index++;
                             while(tape[index]) {
                                 tape[index]--;
-                                index += 4;
-                                tape[index]--;
-                                index -= 14;
-                                tape[index]++;
-                                index += 11;
-                                while(tape[index]) {
-                                    tape[index]--;
-                                    index += 3;
-                                    tape[index]++;
-                                    index -= 3;
+                                tape[index+4]--;
+                                tape[index-10]++;
+                                index++;
+                                if (tape[index] != 0)
+                                {
+                                    tape[index+3] += tape[index];
                                 }
+                                tape[index] = 0;
                                 index--;
                             }
                             index++;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index += 3;
-                                tape[index]--;
-                                index -= 14;
-                                tape[index]++;
-                                index += 11;
+                            if (tape[index] != 0)
+                            {
+                                tape[index+3] -= tape[index];
+                                tape[index-11] += tape[index];
                             }
+                            tape[index] = 0;
                             index -= 2;
                         }
                         index++;
                         while(tape[index]) {
                             tape[index]--;
-                            index += 4;
-                            tape[index]++;
-                            index -= 3;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index += 3;
-                                tape[index]--;
-                                index -= 14;
-                                tape[index]++;
-                                index += 11;
-                            }
-                            index--;
-                        }
-                        index++;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index += 3;
-                            tape[index]++;
-                            index -= 3;
-                        }
-                        index -= 12;
-                    }
-                }
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index += 2;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index += 5;
-                while(tape[index]) {
-                    index += 2;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index += 6;
-                }
-                index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
-                index += 9;
-                while(tape[index]) {
-                    index += 5;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 4;
-                        tape[index]++;
-                        index += 4;
-                    }
-                    index -= 4;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 4;
-                        tape[index]++;
-                        index -= 3;
-                        tape[index]++;
-                        index--;
-                    }
-                    index += 8;
-                }
-                index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
-                index += 9;
-                tape[index] += 15;
-                while(tape[index]) {
-                    while(tape[index]) {
-                        index += 9;
-                    }
-                    tape[index]++;
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index -= 9;
-                    while(tape[index]) {
-                        index -= 9;
+                            tape[index+4]++;
+                            index++;
+                            if (tape[index] != 0)
+                            {
+                                tape[index+3] -= tape[index];
+                                tape[index-11] += tape[index];
+                            }
+                            tape[index] = 0;
+                            index--;
+                        }
+                        index++;
+                        if (tape[index] != 0)
+                        {
+                            tape[index+3] += tape[index];
+                        }
+                        tape[index] = 0;
+                        index -= 12;
                     }
+                }
+                tape[index+1] = 0;
+                tape[index+3] = 0;
+                tape[index+4] = 0;
+                index += 9;
+                while(tape[index]) {
+                    tape[index+2] = 0;
+                    tape[index+3] = 0;
                     index += 9;
-                    tape[index]--;
                 }
-                tape[index]++;
+                index -= 9;
+                index = scan_left(index, 9);
+                index += 9;
                 while(tape[index]) {
-                    index++;
-                    tape[index]++;
+                    index += 5;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-4] += tape[index];
+                    }
+                    tape[index] = 0;
+                    index -= 4;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+4] += tape[index];
+                        tape[index+1] += tape[index];
+                    }
+                    tape[index] = 0;
                     index += 8;
                 }
                 index -= 9;
+                index = scan_left(index, 9);
+                tape[index+9] += 15;
+                index += 9;
                 while(tape[index]) {
-                    index -= 9;
+                    index = scan_right(index, 9);
+                    tape[index]++;
+                    tape[index+1] = 0;
+                    tape[index+2] = 0;
+                    tape[index+3] = 0;
+                    tape[index+4] = 0;
+                    tape[index+5] = 0;
+                    tape[index+6] = 0;
+                    tape[index+7] = 0;
+                    tape[index+8] = 0;
+                    tape[index+9] = 0;
+                    index = scan_left(index, 9);
+                    tape[index+9]--;
+                    index += 9;
+                }
+                tape[index]++;
+                while(tape[index]) {
+                    tape[index+1]++;
+                    index += 9;
                 }
+                index -= 9;
+                index = scan_left(index, 9);
                 index += 9;
                 while(tape[index]) {
-                    index++;
-                    tape[index]--;
-                    index += 4;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 4;
-                        tape[index]++;
-                        index += 4;
+                    tape[index+1]--;
+                    index += 5;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-4] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 4;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 4;
-                        tape[index]++;
-                        index -= 5;
+                        tape[index+4]++;
+                        index--;
                         while(tape[index]) {
                             tape[index]--;
                             index += 2;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index -= 2;
-                                tape[index]++;
-                                index += 2;
+                            if (tape[index] != 0)
+                            {
+                                tape[index-2] += tape[index];
                             }
+                            tape[index] = 0;
                             index -= 2;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index += 2;
-                                tape[index]++;
-                                index++;
-                                tape[index]++;
-                                index -= 3;
+                            if (tape[index] != 0)
+                            {
+                                tape[index+2] += tape[index];
+                                tape[index+3] += tape[index];
                             }
-                            tape[index]++;
+                            tape[index] = 1;
                             index += 9;
                         }
                         index -= 8;
-                        while(tape[index]) {
-                            index -= 9;
-                        }
+                        index = scan_left(index, 9);
                     }
                     index += 9;
-                    while(tape[index]) {
-                        index += 9;
-                    }
+                    index = scan_right(index, 9);
                     index -= 9;
                     while(tape[index]) {
                         index++;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index += 9;
-                            tape[index]++;
-                            index -= 9;
+                        if (tape[index] != 0)
+                        {
+                            tape[index+9] += tape[index];
                         }
+                        tape[index] = 0;
                         index -= 10;
                     }
                     index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 9;
-                        tape[index]++;
-                        index -= 9;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+9] += tape[index];
                     }
-                    index--;
-                    tape[index]++;
-                    index += 8;
+                    tape[index] = 0;
+                    tape[index-1]++;
+                    index += 7;
                 }
                 index -= 9;
                 while(tape[index]) {
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index--;
+                    tape[index+1] = 0;
                     tape[index]--;
                     index += 3;
                     while(tape[index]) {
                         tape[index]--;
-                        index -= 3;
-                        tape[index]++;
-                        index++;
-                        while(tape[index]) {
-                            index--;
-                            tape[index]--;
-                            index++;
-                            tape[index]--;
-                            index -= 7;
-                            tape[index]++;
-                            index += 7;
+                        tape[index-3]++;
+                        index -= 2;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-1] -= tape[index];
+                            tape[index-7] += tape[index];
                         }
+                        tape[index] = 0;
                         index--;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index++;
-                            tape[index]++;
-                            index--;
+                        if (tape[index] != 0)
+                        {
+                            tape[index+1] += tape[index];
                         }
+                        tape[index] = 0;
                         index += 3;
                     }
                     index -= 2;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 2;
-                        tape[index]++;
-                        index -= 2;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+2] += tape[index];
                     }
-                    index--;
-                    tape[index]++;
-                    index -= 9;
+                    tape[index] = 0;
+                    tape[index-1]++;
+                    index -= 10;
                 }
                 index += 9;
                 while(tape[index]) {
                     index += 3;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 36;
-                        tape[index]++;
-                        index += 36;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-36] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 6;
                 }
                 index -= 9;
+                index = scan_left(index, 9);
+                tape[index+5] = 0;
+                tape[index+9] += 15;
+                index += 9;
                 while(tape[index]) {
-                    index -= 9;
-                }
-                index += 5;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index += 4;
-                tape[index] += 15;
-                while(tape[index]) {
-                    while(tape[index]) {
-                        index += 9;
-                    }
-                    index -= 9;
-                    tape[index]--;
-                    index -= 9;
-                    while(tape[index]) {
-                        index -= 9;
-                    }
+                    index = scan_right(index, 9);
+                    tape[index-9]--;
+                    index -= 18;
+                    index = scan_left(index, 9);
+                    tape[index+9]--;
                     index += 9;
-                    tape[index]--;
                 }
                 tape[index]++;
                 while(tape[index]) {
                     index += 3;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 3;
-                        tape[index]--;
-                        index += 3;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-3] -= tape[index];
                     }
-                    tape[index]++;
+                    tape[index] = 1;
                     index -= 3;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 3;
-                        tape[index]--;
-                        index++;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index -= 4;
-                            tape[index]++;
-                            index += 4;
+                        tape[index+3]--;
+                        index += 4;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-4] += tape[index];
                         }
+                        tape[index] = 0;
                         index -= 4;
                         while(tape[index]) {
                             tape[index]--;
-                            index += 4;
-                            tape[index]++;
-                            index -= 13;
-                            while(tape[index]) {
-                                index -= 9;
-                            }
-                            index += 4;
-                            while(tape[index]) {
-                                tape[index]--;
-                            }
-                            tape[index]++;
-                            index += 5;
-                            while(tape[index]) {
-                                index += 9;
-                            }
-                            index++;
-                            tape[index]++;
-                            index--;
+                            tape[index+4]++;
+                            index -= 9;
+                            index = scan_left(index, 9);
+                            tape[index+4] = 1;
+                            index += 9;
+                            index = scan_right(index, 9);
+                            tape[index+1]++;
                         }
                     }
                     tape[index]++;
                     index += 4;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 4;
-                        tape[index]--;
-                        index += 4;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-4] -= tape[index];
                     }
-                    tape[index]++;
+                    tape[index] = 1;
                     index -= 4;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 4;
-                        tape[index]--;
-                        index--;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index -= 3;
-                            tape[index]++;
-                            index += 3;
+                        tape[index+4]--;
+                        index += 3;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-3] += tape[index];
                         }
+                        tape[index] = 0;
                         index -= 3;
                         while(tape[index]) {
                             tape[index]--;
-                            index += 3;
-                            tape[index]++;
-                            index -= 12;
-                            while(tape[index]) {
-                                index -= 9;
-                            }
-                            index += 3;
-                            while(tape[index]) {
-                                tape[index]--;
-                            }
-                            tape[index]++;
-                            index += 6;
-                            while(tape[index]) {
-                                index += 9;
-                            }
-                            index++;
-                            while(tape[index]) {
-                                tape[index]--;
-                            }
-                            tape[index]++;
-                            index--;
+                            tape[index+3]++;
+                            index -= 9;
+                            index = scan_left(index, 9);
+                            tape[index+3] = 1;
+                            index += 9;
+                            index = scan_right(index, 9);
+                            tape[index+1] = 1;
                         }
                     }
                     tape[index]++;
@@ -1969,414 +1602,307 @@ int main(void)
                     while(tape[index]) {
                         tape[index]--;
                         index--;
-                        while(tape[index]) {
-                            index += 9;
-                        }
+                        index = scan_right(index, 9);
                         index -= 8;
                     }
                     index += 8;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
+                index = scan_left(index, 9);
                 index += 3;
-                while(tape[index]) {
-                    tape[index]--;
-                    index -= 3;
-                    tape[index]++;
-                    index += 3;
+                if (tape[index] != 0)
+                {
+                    tape[index-3] += tape[index];
                 }
+                tape[index] = 0;
                 index -= 3;
                 while(tape[index]) {
                     tape[index]--;
-                    index += 3;
-                    tape[index]++;
-                    index += 6;
+                    tape[index+3]++;
+                    index += 9;
                     while(tape[index]) {
-                        index++;
-                        tape[index]++;
-                        index += 3;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index -= 3;
-                            tape[index]--;
-                            index += 3;
+                        tape[index+1]++;
+                        index += 4;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-3] -= tape[index];
                         }
+                        tape[index] = 0;
                         index -= 3;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index += 3;
-                            tape[index]++;
-                            index -= 3;
+                        if (tape[index] != 0)
+                        {
+                            tape[index+3] += tape[index];
                         }
+                        tape[index] = 0;
                         index += 8;
                     }
-                    index -= 8;
-                    tape[index]++;
-                    index--;
+                    tape[index-8]++;
+                    index -= 9;
                     while(tape[index]) {
                         index++;
                         while(tape[index]) {
                             tape[index]--;
-                            index++;
-                            tape[index]++;
-                            index++;
+                            tape[index+1]++;
+                            index += 2;
                             while(tape[index]) {
                                 tape[index]--;
-                                index--;
-                                tape[index]--;
-                                index -= 10;
-                                tape[index]++;
-                                index += 12;
-                                while(tape[index]) {
-                                    tape[index]--;
-                                    index -= 2;
-                                    tape[index]++;
-                                    index += 2;
+                                tape[index-1]--;
+                                tape[index-11]++;
+                                index++;
+                                if (tape[index] != 0)
+                                {
+                                    tape[index-2] += tape[index];
                                 }
+                                tape[index] = 0;
                                 index--;
                             }
                             index++;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index -= 2;
-                                tape[index]--;
-                                index -= 10;
-                                tape[index]++;
-                                index += 12;
+                            if (tape[index] != 0)
+                            {
+                                tape[index-2] -= tape[index];
+                                tape[index-12] += tape[index];
                             }
+                            tape[index] = 0;
                             index -= 3;
                         }
                         index += 2;
                         while(tape[index]) {
                             tape[index]--;
-                            index--;
-                            tape[index]++;
-                            index += 2;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index -= 2;
-                                tape[index]--;
-                                index -= 10;
-                                tape[index]++;
-                                index += 12;
+                            tape[index-1]++;
+                            index++;
+                            if (tape[index] != 0)
+                            {
+                                tape[index-2] -= tape[index];
+                                tape[index-12] += tape[index];
                             }
+                            tape[index] = 0;
                             index--;
                         }
                         index++;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index -= 2;
-                            tape[index]++;
-                            index += 2;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-2] += tape[index];
                         }
+                        tape[index] = 0;
                         index -= 13;
                     }
                 }
                 index += 4;
-                while(tape[index]) {
-                    tape[index]--;
-                    index -= 4;
-                    tape[index]++;
-                    index += 4;
+                if (tape[index] != 0)
+                {
+                    tape[index-4] += tape[index];
                 }
+                tape[index] = 0;
                 index -= 4;
                 while(tape[index]) {
                     tape[index]--;
-                    index += 4;
-                    tape[index]++;
-                    index += 5;
+                    tape[index+4]++;
+                    index += 9;
                     while(tape[index]) {
-                        index++;
-                        tape[index]++;
-                        index += 2;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index -= 2;
-                            tape[index]--;
-                            index += 2;
+                        tape[index+1]++;
+                        index += 3;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-2] -= tape[index];
                         }
+                        tape[index] = 0;
                         index -= 2;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index += 2;
-                            tape[index]++;
-                            index -= 2;
+                        if (tape[index] != 0)
+                        {
+                            tape[index+2] += tape[index];
                         }
+                        tape[index] = 0;
                         index += 8;
-                    }
-                    index -= 8;
-                    tape[index]++;
-                    index--;
+                    }
+                    tape[index-8]++;
+                    index -= 9;
                     while(tape[index]) {
                         index++;
                         while(tape[index]) {
                             tape[index]--;
-                            index++;
-                            tape[index]++;
-                            index += 2;
+                            tape[index+1]++;
+                            index += 3;
                             while(tape[index]) {
                                 tape[index]--;
-                                index -= 2;
-                                tape[index]--;
-                                index -= 10;
-                                tape[index]++;
-                                index += 11;
-                                while(tape[index]) {
-                                    tape[index]--;
-                                    index--;
-                                    tape[index]++;
-                                    index++;
+                                tape[index-2]--;
+                                tape[index-12]++;
+                                index--;
+                                if (tape[index] != 0)
+                                {
+                                    tape[index-1] += tape[index];
                                 }
+                                tape[index] = 0;
                                 index++;
                             }
                             index--;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index--;
-                                tape[index]--;
-                                index -= 10;
-                                tape[index]++;
-                                index += 11;
+                            if (tape[index] != 0)
+                            {
+                                tape[index-1] -= tape[index];
+                                tape[index-11] += tape[index];
                             }
+                            tape[index] = 0;
                             index -= 2;
                         }
                         index += 3;
                         while(tape[index]) {
                             tape[index]--;
-                            index -= 2;
-                            tape[index]++;
-                            index++;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index--;
-                                tape[index]--;
-                                index -= 10;
-                                tape[index]++;
-                                index += 11;
+                            tape[index-2]++;
+                            index--;
+                            if (tape[index] != 0)
+                            {
+                                tape[index-1] -= tape[index];
+                                tape[index-11] += tape[index];
                             }
+                            tape[index] = 0;
                             index++;
                         }
                         index--;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index--;
-                            tape[index]++;
-                            index++;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-1] += tape[index];
                         }
+                        tape[index] = 0;
                         index -= 12;
                     }
-                    index += 5;
-                    tape[index]++;
-                    index -= 5;
+                    tape[index+5]++;
                 }
                 index += 9;
                 while(tape[index]) {
-                    index += 3;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index += 4;
+                    tape[index+3] = 0;
+                    tape[index+4] = 0;
+                    tape[index+5] = 0;
+                    index += 9;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
-                index += 3;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index += 5;
+                index = scan_left(index, 9);
+                tape[index+3] = 0;
+                tape[index+4] = 0;
+                index += 9;
                 while(tape[index]) {
                     index += 7;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 6;
-                        tape[index]++;
-                        index += 6;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-6] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 6;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 6;
-                        tape[index]++;
-                        index -= 4;
-                        tape[index]++;
-                        index -= 2;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+6] += tape[index];
+                        tape[index+2] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 8;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
-                index += 4;
-                tape[index]++;
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                    index--;
-                    tape[index]--;
-                    index -= 4;
-                    tape[index]++;
-                    index += 5;
+                index = scan_left(index, 9);
+                tape[index+4]++;
+                index += 5;
+                if (tape[index] != 0)
+                {
+                    tape[index-1] -= tape[index];
+                    tape[index-5] += tape[index];
                 }
+                tape[index] = 0;
                 index += 2;
                 while(tape[index]) {
                     tape[index]--;
                     index -= 7;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 5;
-                        tape[index]++;
-                        index--;
-                        tape[index] += 2;
-                        index -= 4;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+5] += tape[index];
+                        tape[index+4] += tape[index]*2;
                     }
+                    tape[index] = 0;
                     index += 5;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 5;
-                        tape[index]++;
-                        index += 5;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-5] += tape[index];
                     }
-                    index--;
-                    tape[index]--;
-                    index++;
+                    tape[index] = 0;
+                    tape[index-1]--;
                     tape[index]++;
                     index += 2;
                 }
                 index -= 2;
-                while(tape[index]) {
-                    tape[index]--;
-                    index += 2;
-                    tape[index]++;
-                    index -= 2;
+                if (tape[index] != 0)
+                {
+                    tape[index+2] += tape[index];
                 }
+                tape[index] = 0;
                 index -= 5;
-                while(tape[index]) {
-                    tape[index]--;
-                    index += 5;
-                    tape[index]++;
-                    index -= 5;
+                if (tape[index] != 0)
+                {
+                    tape[index+5] += tape[index];
                 }
-                tape[index]++;
+                tape[index] = 1;
                 index += 4;
-                while(tape[index]) {
-                    tape[index]--;
-                    index -= 4;
-                    tape[index]--;
-                    index += 4;
+                if (tape[index] != 0)
+                {
+                    tape[index-4] -= tape[index];
                 }
-                tape[index]++;
+                tape[index] = 1;
                 index -= 4;
                 while(tape[index]) {
                     tape[index]--;
-                    index += 4;
-                    tape[index]--;
-                    index += 5;
+                    tape[index+4]--;
+                    index += 9;
                     while(tape[index]) {
                         index += 3;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index -= 3;
-                            tape[index]--;
-                            index += 3;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-3] -= tape[index];
                         }
-                        tape[index]++;
+                        tape[index] = 1;
                         index -= 3;
                         while(tape[index]) {
                             tape[index]--;
-                            index += 3;
-                            tape[index]--;
-                            index--;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index -= 2;
-                                tape[index]++;
-                                index += 2;
+                            tape[index+3]--;
+                            index += 2;
+                            if (tape[index] != 0)
+                            {
+                                tape[index-2] += tape[index];
                             }
+                            tape[index] = 0;
                             index -= 2;
                             while(tape[index]) {
                                 tape[index]--;
-                                index += 2;
-                                tape[index]++;
-                                index -= 11;
-                                while(tape[index]) {
-                                    index -= 9;
-                                }
-                                index += 4;
-                                while(tape[index]) {
-                                    tape[index]--;
-                                }
-                                tape[index]++;
-                                index += 5;
-                                while(tape[index]) {
-                                    index += 9;
-                                }
-                                index++;
-                                tape[index]++;
-                                index--;
+                                tape[index+2]++;
+                                index -= 9;
+                                index = scan_left(index, 9);
+                                tape[index+4] = 1;
+                                index += 9;
+                                index = scan_right(index, 9);
+                                tape[index+1]++;
                             }
                         }
                         tape[index]++;
                         index += 2;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index -= 2;
-                            tape[index]--;
-                            index += 2;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-2] -= tape[index];
                         }
-                        tape[index]++;
+                        tape[index] = 1;
                         index -= 2;
                         while(tape[index]) {
                             tape[index]--;
-                            index += 2;
-                            tape[index]--;
-                            index++;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index -= 3;
-                                tape[index]++;
-                                index += 3;
+                            tape[index+2]--;
+                            index += 3;
+                            if (tape[index] != 0)
+                            {
+                                tape[index-3] += tape[index];
                             }
+                            tape[index] = 0;
                             index -= 3;
                             while(tape[index]) {
                                 tape[index]--;
-                                index += 3;
-                                tape[index]++;
-                                index -= 12;
-                                while(tape[index]) {
-                                    index -= 9;
-                                }
-                                index += 3;
-                                while(tape[index]) {
-                                    tape[index]--;
-                                }
-                                tape[index]++;
-                                index += 6;
-                                while(tape[index]) {
-                                    index += 9;
-                                }
-                                index++;
-                                while(tape[index]) {
-                                    tape[index]--;
-                                }
-                                tape[index]++;
-                                index--;
+                                tape[index+3]++;
+                                index -= 9;
+                                index = scan_left(index, 9);
+                                tape[index+3] = 1;
+                                index += 9;
+                                index = scan_right(index, 9);
+                                tape[index+1] = 1;
                             }
                         }
                         tape[index]++;
@@ -2384,820 +1910,598 @@ int main(void)
                         while(tape[index]) {
                             tape[index]--;
                             index--;
-                            while(tape[index]) {
-                                index += 9;
-                            }
+                            index = scan_right(index, 9);
                             index -= 8;
                         }
                         index += 8;
                     }
                     index -= 9;
-                    while(tape[index]) {
-                        index -= 9;
-                    }
+                    index = scan_left(index, 9);
                     index += 3;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 3;
-                        tape[index]++;
-                        index += 3;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-3] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 3;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 3;
-                        tape[index]++;
-                        index += 6;
+                        tape[index+3]++;
+                        index += 9;
                         while(tape[index]) {
-                            index++;
-                            tape[index]++;
-                            index++;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index--;
-                                tape[index]--;
-                                index++;
+                            tape[index+1]++;
+                            index += 2;
+                            if (tape[index] != 0)
+                            {
+                                tape[index-1] -= tape[index];
                             }
+                            tape[index] = 0;
                             index--;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index++;
-                                tape[index]++;
-                                index--;
+                            if (tape[index] != 0)
+                            {
+                                tape[index+1] += tape[index];
                             }
+                            tape[index] = 0;
                             index += 8;
                         }
-                        index -= 8;
-                        tape[index]++;
-                        index--;
+                        tape[index-8]++;
+                        index -= 9;
                         while(tape[index]) {
                             index++;
                             while(tape[index]) {
                                 tape[index]--;
-                                index += 4;
-                                tape[index]++;
-                                index -= 2;
+                                tape[index+4]++;
+                                index += 2;
                                 while(tape[index]) {
                                     tape[index]--;
-                                    index += 2;
-                                    tape[index]--;
-                                    index -= 13;
-                                    tape[index]++;
-                                    index += 10;
-                                    while(tape[index]) {
-                                        tape[index]--;
-                                        index += 3;
-                                        tape[index]++;
-                                        index -= 3;
+                                    tape[index+2]--;
+                                    tape[index-11]++;
+                                    index--;
+                                    if (tape[index] != 0)
+                                    {
+                                        tape[index+3] += tape[index];
                                     }
+                                    tape[index] = 0;
                                     index++;
                                 }
                                 index--;
-                                while(tape[index]) {
-                                    tape[index]--;
-                                    index += 3;
-                                    tape[index]--;
-                                    index -= 13;
-                                    tape[index]++;
-                                    index += 10;
+                                if (tape[index] != 0)
+                                {
+                                    tape[index+3] -= tape[index];
+                                    tape[index-10] += tape[index];
                                 }
+                                tape[index] = 0;
                                 index--;
                             }
                             index += 2;
                             while(tape[index]) {
                                 tape[index]--;
-                                index += 2;
-                                tape[index]++;
-                                index -= 3;
-                                while(tape[index]) {
-                                    tape[index]--;
-                                    index += 3;
-                                    tape[index]--;
-                                    index -= 13;
-                                    tape[index]++;
-                                    index += 10;
+                                tape[index+2]++;
+                                index--;
+                                if (tape[index] != 0)
+                                {
+                                    tape[index+3] -= tape[index];
+                                    tape[index-10] += tape[index];
                                 }
+                                tape[index] = 0;
                                 index++;
                             }
                             index--;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index += 3;
-                                tape[index]++;
-                                index -= 3;
+                            if (tape[index] != 0)
+                            {
+                                tape[index+3] += tape[index];
                             }
+                            tape[index] = 0;
                             index -= 11;
                         }
-                        index += 5;
-                        while(tape[index]) {
-                            tape[index]--;
-                        }
-                        index += 2;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index -= 7;
-                            tape[index]++;
-                            index += 7;
+                        tape[index+5] = 0;
+                        index += 7;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-7] += tape[index];
                         }
+                        tape[index] = 0;
                         index -= 7;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index += 7;
-                            tape[index]++;
-                            index -= 2;
-                            tape[index]++;
-                            index -= 5;
+                        if (tape[index] != 0)
+                        {
+                            tape[index+7] += tape[index];
+                            tape[index+5] += tape[index];
                         }
+                        tape[index] = 0;
                     }
                     index += 4;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 4;
-                        tape[index]++;
-                        index += 4;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-4] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 4;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 4;
-                        tape[index]++;
-                        index += 5;
+                        tape[index+4]++;
+                        index += 9;
                         while(tape[index]) {
-                            index++;
-                            tape[index]++;
-                            index += 2;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index -= 2;
-                                tape[index]--;
-                                index += 2;
+                            tape[index+1]++;
+                            index += 3;
+                            if (tape[index] != 0)
+                            {
+                                tape[index-2] -= tape[index];
                             }
+                            tape[index] = 0;
                             index -= 2;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index += 2;
-                                tape[index]++;
-                                index -= 2;
+                            if (tape[index] != 0)
+                            {
+                                tape[index+2] += tape[index];
                             }
+                            tape[index] = 0;
                             index += 8;
                         }
-                        index -= 8;
-                        tape[index]++;
-                        index--;
+                        tape[index-8]++;
+                        index -= 9;
                         while(tape[index]) {
                             index++;
                             while(tape[index]) {
                                 tape[index]--;
-                                index += 4;
-                                tape[index]++;
-                                index -= 3;
+                                tape[index+4]++;
+                                index++;
                                 while(tape[index]) {
                                     tape[index]--;
-                                    index += 3;
-                                    tape[index]--;
-                                    index -= 13;
-                                    tape[index]++;
-                                    index += 11;
-                                    while(tape[index]) {
-                                        tape[index]--;
-                                        index += 2;
-                                        tape[index]++;
-                                        index -= 2;
+                                    tape[index+3]--;
+                                    tape[index-10]++;
+                                    index++;
+                                    if (tape[index] != 0)
+                                    {
+                                        tape[index+2] += tape[index];
                                     }
+                                    tape[index] = 0;
                                     index--;
                                 }
-                                index++;
-                                while(tape[index]) {
-                                    tape[index]--;
-                                    index += 2;
-                                    tape[index]--;
-                                    index -= 13;
-                                    tape[index]++;
-                                    index += 11;
-                                }
+                                index++;
+                                if (tape[index] != 0)
+                                {
+                                    tape[index+2] -= tape[index];
+                                    tape[index-11] += tape[index];
+                                }
+                                tape[index] = 0;
                                 index -= 2;
                             }
                             index++;
                             while(tape[index]) {
                                 tape[index]--;
-                                index += 3;
-                                tape[index]++;
-                                index -= 2;
-                                while(tape[index]) {
-                                    tape[index]--;
-                                    index += 2;
-                                    tape[index]--;
-                                    index -= 13;
-                                    tape[index]++;
-                                    index += 11;
+                                tape[index+3]++;
+                                index++;
+                                if (tape[index] != 0)
+                                {
+                                    tape[index+2] -= tape[index];
+                                    tape[index-11] += tape[index];
                                 }
+                                tape[index] = 0;
                                 index--;
                             }
                             index++;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index += 2;
-                                tape[index]++;
-                                index -= 2;
+                            if (tape[index] != 0)
+                            {
+                                tape[index+2] += tape[index];
                             }
+                            tape[index] = 0;
                             index -= 12;
                         }
                     }
-                    index += 4;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index -= 4;
+                    tape[index+4] = 0;
                 }
                 index += 4;
-                while(tape[index]) {
-                    tape[index]--;
-                    index -= 4;
-                    tape[index]++;
-                    index += 4;
+                if (tape[index] != 0)
+                {
+                    tape[index-4] += tape[index];
                 }
+                tape[index] = 0;
                 index -= 4;
                 while(tape[index]) {
                     tape[index]--;
-                    index += 4;
-                    tape[index]++;
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index += 2;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 7;
-                        tape[index]++;
-                        index += 7;
+                    tape[index+4]++;
+                    tape[index+5] = 0;
+                    index += 7;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-7] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 7;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 7;
-                        tape[index]++;
-                        index -= 2;
-                        tape[index]++;
-                        index -= 5;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+7] += tape[index];
+                        tape[index+5] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 9;
-                    while(tape[index]) {
-                        index += 9;
-                    }
+                    index = scan_right(index, 9);
                     index -= 9;
                     while(tape[index]) {
                         index++;
                         while(tape[index]) {
                             tape[index]--;
-                            index += 4;
-                            tape[index]++;
-                            index -= 3;
+                            tape[index+4]++;
+                            index++;
                             while(tape[index]) {
                                 tape[index]--;
-                                index += 3;
-                                tape[index]--;
-                                index -= 13;
-                                tape[index]++;
-                                index += 11;
-                                while(tape[index]) {
-                                    tape[index]--;
-                                    index += 2;
-                                    tape[index]++;
-                                    index -= 2;
+                                tape[index+3]--;
+                                tape[index-10]++;
+                                index++;
+                                if (tape[index] != 0)
+                                {
+                                    tape[index+2] += tape[index];
                                 }
+                                tape[index] = 0;
                                 index--;
                             }
                             index++;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index += 2;
-                                tape[index]--;
-                                index -= 13;
-                                tape[index]++;
-                                index += 11;
+                            if (tape[index] != 0)
+                            {
+                                tape[index+2] -= tape[index];
+                                tape[index-11] += tape[index];
                             }
+                            tape[index] = 0;
                             index -= 2;
                         }
                         index++;
                         while(tape[index]) {
                             tape[index]--;
-                            index += 3;
-                            tape[index]++;
-                            index -= 2;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index += 2;
-                                tape[index]--;
-                                index -= 13;
-                                tape[index]++;
-                                index += 11;
+                            tape[index+3]++;
+                            index++;
+                            if (tape[index] != 0)
+                            {
+                                tape[index+2] -= tape[index];
+                                tape[index-11] += tape[index];
                             }
+                            tape[index] = 0;
                             index--;
                         }
                         index++;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index += 2;
-                            tape[index]++;
-                            index -= 2;
+                        if (tape[index] != 0)
+                        {
+                            tape[index+2] += tape[index];
                         }
+                        tape[index] = 0;
                         index -= 12;
                     }
                 }
                 index += 9;
                 while(tape[index]) {
-                    index += 2;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index += 6;
+                    tape[index+2] = 0;
+                    tape[index+3] = 0;
+                    index += 9;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
-                index += 3;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index += 5;
+                index = scan_left(index, 9);
+                tape[index+3] = 0;
+                tape[index+4] = 0;
+                index += 9;
                 while(tape[index]) {
                     index += 5;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 4;
-                        tape[index]++;
-                        index += 4;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-4] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 4;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 4;
-                        tape[index]++;
-                        index -= 3;
-                        tape[index]++;
-                        index--;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+4] += tape[index];
+                        tape[index+1] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 8;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
+                index = scan_left(index, 9);
                 index += 9;
                 while(tape[index]) {
                     index += 6;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 5;
-                        tape[index]++;
-                        index += 5;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-5] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 5;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 5;
-                        tape[index]++;
-                        index -= 3;
-                        tape[index]++;
-                        index -= 2;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+5] += tape[index];
+                        tape[index+2] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 8;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
+                index = scan_left(index, 9);
+                tape[index+9] += 15;
                 index += 9;
-                tape[index] += 15;
                 while(tape[index]) {
-                    while(tape[index]) {
-                        index += 9;
-                    }
-                    tape[index]++;
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index -= 9;
-                    while(tape[index]) {
-                        index -= 9;
-                    }
+                    index = scan_right(index, 9);
+                    tape[index]++;
+                    tape[index+1] = 0;
+                    tape[index+2] = 0;
+                    tape[index+3] = 0;
+                    tape[index+4] = 0;
+                    tape[index+5] = 0;
+                    tape[index+6] = 0;
+                    tape[index+7] = 0;
+                    tape[index+8] = 0;
+                    tape[index+9] = 0;
+                    index = scan_left(index, 9);
+                    tape[index+9]--;
                     index += 9;
-                    tape[index]--;
                 }
                 tape[index]++;
                 while(tape[index]) {
-                    index++;
-                    tape[index]++;
-                    index += 8;
+                    tape[index+1]++;
+                    index += 9;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
+                index = scan_left(index, 9);
                 index += 9;
                 while(tape[index]) {
-                    index++;
-                    tape[index]--;
-                    index += 4;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 4;
-                        tape[index]++;
-                        index += 4;
+                    tape[index+1]--;
+                    index += 5;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-4] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 4;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 4;
-                        tape[index]++;
-                        index -= 5;
+                        tape[index+4]++;
+                        index--;
                         while(tape[index]) {
                             tape[index]--;
                             index += 2;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index -= 2;
-                                tape[index]++;
-                                index += 2;
+                            if (tape[index] != 0)
+                            {
+                                tape[index-2] += tape[index];
                             }
+                            tape[index] = 0;
                             index -= 2;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index += 2;
-                                tape[index]++;
-                                index += 2;
-                                tape[index]++;
-                                index -= 4;
+                            if (tape[index] != 0)
+                            {
+                                tape[index+2] += tape[index];
+                                tape[index+4] += tape[index];
                             }
-                            tape[index]++;
+                            tape[index] = 1;
                             index += 9;
                         }
                         index -= 8;
-                        while(tape[index]) {
-                            index -= 9;
-                        }
+                        index = scan_left(index, 9);
                     }
                     index += 9;
-                    while(tape[index]) {
-                        index += 9;
-                    }
+                    index = scan_right(index, 9);
                     index -= 9;
                     while(tape[index]) {
                         index++;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index += 9;
-                            tape[index]++;
-                            index -= 9;
+                        if (tape[index] != 0)
+                        {
+                            tape[index+9] += tape[index];
                         }
+                        tape[index] = 0;
                         index -= 10;
                     }
                     index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 9;
-                        tape[index]++;
-                        index -= 9;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+9] += tape[index];
                     }
-                    index--;
-                    tape[index]++;
-                    index += 8;
+                    tape[index] = 0;
+                    tape[index-1]++;
+                    index += 7;
                 }
                 index -= 9;
                 while(tape[index]) {
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index--;
+                    tape[index+1] = 0;
                     tape[index]--;
                     index += 4;
                     while(tape[index]) {
                         tape[index]--;
-                        index -= 4;
-                        tape[index]++;
-                        index++;
-                        while(tape[index]) {
-                            index--;
-                            tape[index]--;
-                            index++;
-                            tape[index]--;
-                            index -= 6;
-                            tape[index]++;
-                            index += 6;
+                        tape[index-4]++;
+                        index -= 3;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-1] -= tape[index];
+                            tape[index-6] += tape[index];
                         }
+                        tape[index] = 0;
                         index--;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index++;
-                            tape[index]++;
-                            index--;
+                        if (tape[index] != 0)
+                        {
+                            tape[index+1] += tape[index];
                         }
+                        tape[index] = 0;
                         index += 4;
                     }
                     index -= 3;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 3;
-                        tape[index]++;
-                        index -= 3;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+3] += tape[index];
                     }
-                    index--;
-                    tape[index]++;
-                    index -= 9;
-                }
-                index += 9;
-                while(tape[index]) {
-                    index++;
-                    tape[index]++;
-                    index += 8;
-                }
-                index -= 9;
-                while(tape[index]) {
-                    index -= 9;
+                    tape[index] = 0;
+                    tape[index-1]++;
+                    index -= 10;
                 }
                 index += 9;
-                while(tape[index]) {
-                    index++;
-                    tape[index]--;
-                    index += 5;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 5;
-                        tape[index]++;
-                        index += 5;
+                while(tape[index]) {
+                    tape[index+1]++;
+                    index += 9;
+                }
+                index -= 9;
+                index = scan_left(index, 9);
+                index += 9;
+                while(tape[index]) {
+                    tape[index+1]--;
+                    index += 6;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-5] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 5;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 5;
-                        tape[index]++;
-                        index -= 6;
+                        tape[index+5]++;
+                        index--;
                         while(tape[index]) {
                             tape[index]--;
                             index += 3;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index -= 3;
-                                tape[index]++;
-                                index += 3;
+                            if (tape[index] != 0)
+                            {
+                                tape[index-3] += tape[index];
                             }
+                            tape[index] = 0;
                             index -= 3;
-                            while(tape[index]) {
-                                tape[index]--;
-                                index += 3;
-                                tape[index]++;
-                                index++;
-                                tape[index]++;
-                                index -= 4;
+                            if (tape[index] != 0)
+                            {
+                                tape[index+3] += tape[index];
+                                tape[index+4] += tape[index];
                             }
-                            tape[index]++;
+                            tape[index] = 1;
                             index += 9;
                         }
                         index -= 8;
-                        while(tape[index]) {
-                            index -= 9;
-                        }
+                        index = scan_left(index, 9);
                     }
                     index += 9;
-                    while(tape[index]) {
-                        index += 9;
-                    }
+                    index = scan_right(index, 9);
                     index -= 9;
                     while(tape[index]) {
                         index += 2;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index += 9;
-                            tape[index]++;
-                            index -= 9;
+                        if (tape[index] != 0)
+                        {
+                            tape[index+9] += tape[index];
                         }
+                        tape[index] = 0;
                         index -= 11;
                     }
                     index += 2;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 9;
-                        tape[index]++;
-                        index -= 9;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+9] += tape[index];
                     }
-                    index -= 2;
-                    tape[index]++;
-                    index += 8;
+                    tape[index] = 0;
+                    tape[index-2]++;
+                    index += 6;
                 }
                 index -= 9;
                 while(tape[index]) {
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index--;
+                    tape[index+1] = 0;
                     tape[index]--;
                     index += 4;
                     while(tape[index]) {
                         tape[index]--;
-                        index -= 4;
-                        tape[index]++;
-                        index++;
-                        while(tape[index]) {
-                            index--;
-                            tape[index]--;
-                            index++;
-                            tape[index]--;
-                            index -= 6;
-                            tape[index]++;
-                            index += 6;
+                        tape[index-4]++;
+                        index -= 3;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-1] -= tape[index];
+                            tape[index-6] += tape[index];
                         }
+                        tape[index] = 0;
                         index--;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index++;
-                            tape[index]++;
-                            index--;
+                        if (tape[index] != 0)
+                        {
+                            tape[index+1] += tape[index];
                         }
+                        tape[index] = 0;
                         index += 4;
                     }
                     index -= 3;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 3;
-                        tape[index]++;
-                        index -= 3;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+3] += tape[index];
                     }
-                    index--;
-                    tape[index]++;
-                    index -= 9;
+                    tape[index] = 0;
+                    tape[index-1]++;
+                    index -= 10;
                 }
                 index += 9;
                 while(tape[index]) {
                     index += 4;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 36;
-                        tape[index]++;
-                        index += 36;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-36] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 5;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
+                index = scan_left(index, 9);
+                tape[index+9] += 15;
                 index += 9;
-                tape[index] += 15;
                 while(tape[index]) {
-                    while(tape[index]) {
-                        index += 9;
-                    }
-                    index -= 9;
-                    tape[index]--;
-                    index -= 9;
-                    while(tape[index]) {
-                        index -= 9;
-                    }
+                    index = scan_right(index, 9);
+                    tape[index-9]--;
+                    index -= 18;
+                    index = scan_left(index, 9);
+                    tape[index+9]--;
                     index += 9;
-                    tape[index]--;
                 }
                 tape[index]++;
-                index += 21;
-                tape[index]++;
-                index -= 3;
-                while(tape[index]) {
-                    index -= 9;
-                }
+                tape[index+21]++;
+                index += 18;
+                index = scan_left(index, 9);
                 index += 9;
                 while(tape[index]) {
                     index += 3;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 3;
-                        tape[index]--;
-                        index += 3;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-3] -= tape[index];
                     }
-                    tape[index]++;
+                    tape[index] = 1;
                     index -= 3;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 3;
-                        tape[index]--;
-                        index++;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index -= 4;
-                            tape[index]++;
-                            index += 4;
+                        tape[index+3]--;
+                        index += 4;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-4] += tape[index];
                         }
+                        tape[index] = 0;
                         index -= 4;
                         while(tape[index]) {
                             tape[index]--;
-                            index += 4;
-                            tape[index]++;
-                            index -= 13;
-                            while(tape[index]) {
-                                index -= 9;
-                            }
-                            index += 4;
-                            while(tape[index]) {
-                                tape[index]--;
-                            }
-                            tape[index]++;
-                            index += 5;
-                            while(tape[index]) {
-                                index += 9;
-                            }
-                            index++;
-                            tape[index]++;
-                            index--;
+                            tape[index+4]++;
+                            index -= 9;
+                            index = scan_left(index, 9);
+                            tape[index+4] = 1;
+                            index += 9;
+                            index = scan_right(index, 9);
+                            tape[index+1]++;
                         }
                     }
                     tape[index]++;
                     index += 4;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 4;
-                        tape[index]--;
-                        index += 4;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-4] -= tape[index];
                     }
-                    tape[index]++;
+                    tape[index] = 1;
                     index -= 4;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 4;
-                        tape[index]--;
-                        index--;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index -= 3;
-                            tape[index]++;
-                            index += 3;
+                        tape[index+4]--;
+                        index += 3;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-3] += tape[index];
                         }
+                        tape[index] = 0;
                         index -= 3;
                         while(tape[index]) {
                             tape[index]--;
-                            index += 3;
-                            tape[index]++;
-                            index -= 12;
-                            while(tape[index]) {
-                                index -= 9;
-                            }
-                            index += 3;
-                            while(tape[index]) {
-                                tape[index]--;
-                            }
-                            tape[index]++;
-                            index += 6;
-                            while(tape[index]) {
-                                index += 9;
-                            }
-                            index++;
-                            while(tape[index]) {
-                                tape[index]--;
-                            }
-                            tape[index]++;
-                            index--;
+                            tape[index+3]++;
+                            index -= 9;
+                            index = scan_left(index, 9);
+                            tape[index+3] = 1;
+                            index += 9;
+                            index = scan_right(index, 9);
+                            tape[index+1] = 1;
                         }
                     }
                     tape[index]++;
@@ -3205,477 +2509,318 @@ int main(void)
                     while(tape[index]) {
                         tape[index]--;
                         index--;
-                        while(tape[index]) {
-                            index += 9;
-                        }
+                        index = scan_right(index, 9);
                         index -= 8;
                     }
                     index += 8;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
-                index += 2;
-                tape[index]--;
-                index += 2;
-                while(tape[index]) {
-                    tape[index]--;
-                    index -= 4;
-                    tape[index]++;
-                    index += 4;
+                index = scan_left(index, 9);
+                tape[index+2]--;
+                index += 4;
+                if (tape[index] != 0)
+                {
+                    tape[index-4] += tape[index];
                 }
+                tape[index] = 0;
                 index -= 4;
                 while(tape[index]) {
                     tape[index]--;
-                    index += 4;
-                    tape[index]++;
-                    index -= 2;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index -= 2;
+                    tape[index+4]++;
+                    tape[index+2] = 0;
                 }
                 index += 2;
             }
-            index -= 2;
-            tape[index]++;
-            index += 4;
-            while(tape[index]) {
-                tape[index]--;
-                index -= 4;
-                tape[index]--;
-                index += 4;
+            tape[index-2]++;
+            index += 2;
+            if (tape[index] != 0)
+            {
+                tape[index-4] -= tape[index];
             }
-            tape[index]++;
+            tape[index] = 1;
             index -= 4;
             while(tape[index]) {
                 tape[index]--;
-                index += 4;
-                tape[index]--;
-                index -= 6;
-                putchar(tape[index]);
-                index += 2;
+                tape[index+4]--;
+                put(tape[index-2]);
             }
             index += 4;
             while(tape[index]) {
                 tape[index]--;
-                index -= 7;
-                putchar(tape[index]);
-                index += 7;
-            }
-            index -= 3;
-            while(tape[index]) {
-                tape[index]--;
-            }
-            index++;
-            while(tape[index]) {
-                tape[index]--;
-            }
-            index++;
-            while(tape[index]) {
-                tape[index]--;
-            }
-            index++;
-            while(tape[index]) {
-                tape[index]--;
-            }
-            index++;
-            while(tape[index]) {
-                tape[index]--;
-            }
-            index++;
-            while(tape[index]) {
-                tape[index]--;
-            }
-            index += 3;
-            while(tape[index]) {
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index += 3;
-            }
-            index -= 9;
-            while(tape[index]) {
-                index -= 9;
-            }
-            index += 9;
-            while(tape[index]) {
-                index += 5;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index += 4;
-            }
-            index -= 9;
-            while(tape[index]) {
-                index -= 9;
-            }
-            index++;
-            tape[index] += 11;
-            while(tape[index]) {
-                tape[index]--;
-                while(tape[index]) {
-                    tape[index]--;
-                    index += 9;
-                    tape[index]++;
-                    index -= 9;
-                }
+                put(tape[index-7]);
+            }
+            tape[index-3] = 0;
+            tape[index-2] = 0;
+            tape[index-1] = 0;
+            tape[index] = 0;
+            tape[index+1] = 0;
+            tape[index+2] = 0;
+            index += 5;
+            while(tape[index]) {
+                tape[index+1] = 0;
+                tape[index+2] = 0;
+                tape[index+3] = 0;
+                tape[index+4] = 0;
+                tape[index+5] = 0;
+                tape[index+6] = 0;
                 index += 9;
             }
-            index += 4;
-            tape[index]++;
+            index -= 9;
+            index = scan_left(index, 9);
             index += 9;
-            tape[index]++;
-            index -= 14;
             while(tape[index]) {
-                index -= 9;
+                tape[index+5] = 0;
+                index += 9;
             }
-            index += 7;
+            index -= 9;
+            index = scan_left(index, 9);
+            tape[index+1] += 11;
+            index++;
             while(tape[index]) {
                 tape[index]--;
-                index -= 7;
-                tape[index]++;
-                index += 7;
+                if (tape[index] != 0)
+                {
+                    tape[index+9] += tape[index];
+                }
+                tape[index] = 0;
+                index += 9;
+            }
+            tape[index+4]++;
+            tape[index+13]++;
+            index--;
+            index = scan_left(index, 9);
+            index += 7;
+            if (tape[index] != 0)
+            {
+                tape[index-7] += tape[index];
             }
+            tape[index] = 0;
             index -= 7;
             while(tape[index]) {
                 tape[index]--;
-                index += 7;
-                tape[index]++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index += 2;
-                while(tape[index]) {
-                    index += 9;
-                }
+                tape[index+7]++;
+                tape[index+7] = 0;
+                index += 9;
+                index = scan_right(index, 9);
                 index -= 9;
                 while(tape[index]) {
                     index += 7;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 6;
-                        tape[index]++;
-                        index += 6;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-6] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 6;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 6;
-                        tape[index]++;
-                        index -= 7;
-                        while(tape[index]) {
-                            index -= 9;
-                        }
-                        index += 7;
-                        while(tape[index]) {
-                            tape[index]--;
-                        }
-                        tape[index]++;
-                        index += 3;
+                        tape[index+6]++;
+                        index--;
+                        index = scan_left(index, 9);
+                        tape[index+7] = 1;
+                        index += 10;
                     }
                     index -= 10;
                 }
             }
             index += 7;
-            while(tape[index]) {
-                tape[index]--;
-                index -= 7;
-                tape[index]++;
-                index += 7;
+            if (tape[index] != 0)
+            {
+                tape[index-7] += tape[index];
             }
+            tape[index] = 0;
             index -= 7;
             while(tape[index]) {
                 tape[index]--;
-                index += 7;
-                tape[index]++;
-                index += 2;
+                tape[index+7]++;
+                index += 9;
                 while(tape[index]) {
-                    index++;
-                    tape[index]++;
-                    index += 4;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 4;
-                        tape[index]--;
-                        index += 4;
+                    tape[index+1]++;
+                    index += 5;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-4] -= tape[index];
                     }
+                    tape[index] = 0;
                     index -= 4;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 4;
-                        tape[index]++;
-                        index -= 4;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+4] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 8;
                 }
-                index -= 2;
-                tape[index]++;
-                index -= 7;
+                tape[index-2]++;
+                index -= 9;
                 while(tape[index]) {
                     index += 5;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 2;
-                        tape[index]++;
-                        index -= 2;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+2] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 14;
                 }
                 index += 9;
-                while(tape[index]) {
-                    index += 9;
-                }
+                index = scan_right(index, 9);
                 index -= 9;
                 while(tape[index]) {
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index--;
+                    tape[index+1] = 0;
                     tape[index]--;
                     index += 7;
                     while(tape[index]) {
                         tape[index]--;
-                        index -= 7;
-                        tape[index]++;
-                        index++;
-                        while(tape[index]) {
-                            index--;
-                            tape[index]--;
-                            index++;
-                            tape[index]--;
-                            index -= 3;
-                            tape[index]++;
-                            index += 3;
+                        tape[index-7]++;
+                        index -= 6;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-1] -= tape[index];
+                            tape[index-3] += tape[index];
                         }
+                        tape[index] = 0;
                         index--;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index++;
-                            tape[index]++;
-                            index--;
+                        if (tape[index] != 0)
+                        {
+                            tape[index+1] += tape[index];
                         }
+                        tape[index] = 0;
                         index += 7;
                     }
                     index -= 6;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 6;
-                        tape[index]++;
-                        index -= 6;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+6] += tape[index];
                     }
-                    index--;
-                    tape[index]++;
-                    index -= 9;
-                }
-                index += 7;
-                tape[index]--;
-                index -= 4;
-                while(tape[index]) {
-                    tape[index]--;
+                    tape[index] = 0;
+                    tape[index-1]++;
+                    index -= 10;
                 }
-                tape[index]++;
-                index -= 3;
+                tape[index+7]--;
+                tape[index+3] = 1;
             }
             tape[index]++;
             index += 7;
-            while(tape[index]) {
-                tape[index]--;
-                index -= 7;
-                tape[index]--;
-                index += 7;
+            if (tape[index] != 0)
+            {
+                tape[index-7] -= tape[index];
             }
-            tape[index]++;
+            tape[index] = 1;
             index -= 7;
             while(tape[index]) {
                 tape[index]--;
-                index += 7;
-                tape[index]--;
-                index += 2;
+                tape[index+7]--;
+                index += 9;
                 while(tape[index]) {
                     index += 5;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 2;
-                        tape[index]++;
-                        index -= 2;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+2] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 4;
                 }
                 index -= 9;
                 while(tape[index]) {
-                    index++;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    index--;
+                    tape[index+1] = 0;
                     tape[index]--;
                     index += 7;
                     while(tape[index]) {
                         tape[index]--;
-                        index -= 7;
-                        tape[index]++;
-                        index++;
-                        while(tape[index]) {
-                            index--;
-                            tape[index]--;
-                            index++;
-                            tape[index]--;
-                            index -= 3;
-                            tape[index]++;
-                            index += 3;
+                        tape[index-7]++;
+                        index -= 6;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-1] -= tape[index];
+                            tape[index-3] += tape[index];
                         }
+                        tape[index] = 0;
                         index--;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index++;
-                            tape[index]++;
-                            index--;
+                        if (tape[index] != 0)
+                        {
+                            tape[index+1] += tape[index];
                         }
+                        tape[index] = 0;
                         index += 7;
                     }
                     index -= 6;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 6;
-                        tape[index]++;
-                        index -= 6;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+6] += tape[index];
                     }
-                    index--;
-                    tape[index]++;
-                    index -= 9;
+                    tape[index] = 0;
+                    tape[index-1]++;
+                    index -= 10;
                 }
+                tape[index+1] += 5;
                 index++;
-                tape[index] += 5;
                 while(tape[index]) {
                     tape[index]--;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 9;
-                        tape[index]++;
-                        index -= 9;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+9] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 9;
                 }
-                index += 4;
-                tape[index]++;
-                index -= 5;
-                while(tape[index]) {
-                    index -= 9;
-                }
+                tape[index+4]++;
+                index--;
+                index = scan_left(index, 9);
                 index += 9;
                 while(tape[index]) {
                     index += 5;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 5;
-                        tape[index]--;
-                        index += 5;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-5] -= tape[index];
                     }
-                    tape[index]++;
+                    tape[index] = 1;
                     index -= 5;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 5;
-                        tape[index]--;
-                        index += 2;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index -= 7;
-                            tape[index]++;
-                            index += 7;
+                        tape[index+5]--;
+                        index += 7;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-7] += tape[index];
                         }
+                        tape[index] = 0;
                         index -= 7;
                         while(tape[index]) {
                             tape[index]--;
-                            index += 7;
-                            tape[index]++;
-                            index -= 16;
-                            while(tape[index]) {
-                                index -= 9;
-                            }
-                            index += 4;
-                            while(tape[index]) {
-                                tape[index]--;
-                            }
-                            tape[index]++;
-                            index += 5;
-                            while(tape[index]) {
-                                index += 9;
-                            }
-                            index++;
-                            tape[index]++;
-                            index--;
+                            tape[index+7]++;
+                            index -= 9;
+                            index = scan_left(index, 9);
+                            tape[index+4] = 1;
+                            index += 9;
+                            index = scan_right(index, 9);
+                            tape[index+1]++;
                         }
                     }
                     tape[index]++;
                     index += 7;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 7;
-                        tape[index]--;
-                        index += 7;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-7] -= tape[index];
                     }
-                    tape[index]++;
+                    tape[index] = 1;
                     index -= 7;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 7;
-                        tape[index]--;
-                        index -= 2;
-                        while(tape[index]) {
-                            tape[index]--;
-                            index -= 5;
-                            tape[index]++;
-                            index += 5;
+                        tape[index+7]--;
+                        index += 5;
+                        if (tape[index] != 0)
+                        {
+                            tape[index-5] += tape[index];
                         }
+                        tape[index] = 0;
                         index -= 5;
                         while(tape[index]) {
                             tape[index]--;
-                            index += 5;
-                            tape[index]++;
-                            index -= 14;
-                            while(tape[index]) {
-                                index -= 9;
-                            }
-                            index += 3;
-                            while(tape[index]) {
-                                tape[index]--;
-                            }
-                            tape[index]++;
-                            index += 6;
-                            while(tape[index]) {
-                                index += 9;
-                            }
-                            index++;
-                            while(tape[index]) {
-                                tape[index]--;
-                            }
-                            tape[index]++;
-                            index--;
+                            tape[index+5]++;
+                            index -= 9;
+                            index = scan_left(index, 9);
+                            tape[index+3] = 1;
+                            index += 9;
+                            index = scan_right(index, 9);
+                            tape[index+1] = 1;
                         }
                     }
                     tape[index]++;
@@ -3683,402 +2828,287 @@ int main(void)
                     while(tape[index]) {
                         tape[index]--;
                         index--;
-                        while(tape[index]) {
-                            index += 9;
-                        }
+                        index = scan_right(index, 9);
                         index -= 8;
                     }
                     index += 8;
                 }
                 index -= 9;
-                while(tape[index]) {
-                    index -= 9;
-                }
-                index += 4;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index -= 3;
-                tape[index] += 5;
+                index = scan_left(index, 9);
+                tape[index+4] = 0;
+                tape[index+1] += 5;
+                index++;
                 while(tape[index]) {
                     tape[index]--;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index += 9;
-                        tape[index]++;
-                        index -= 9;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+9] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 9;
                 }
-                index += 4;
-                tape[index]--;
-                index -= 5;
-                while(tape[index]) {
-                    index -= 9;
-                }
-            }
-            index += 3;
-        }
-        index -= 4;
-        putchar(tape[index]);
-        index += 10;
-        while(tape[index]) {
-            index += 6;
-            while(tape[index]) {
-                tape[index]--;
+                tape[index+4]--;
+                index--;
+                index = scan_left(index, 9);
             }
             index += 3;
         }
-        index -= 9;
+        put(tape[index-4]);
+        index += 6;
         while(tape[index]) {
-            index -= 9;
+            tape[index+6] = 0;
+            index += 9;
         }
+        index -= 9;
+        index = scan_left(index, 9);
+        tape[index+1] += 10;
         index++;
-        tape[index] += 10;
         while(tape[index]) {
             tape[index]--;
-            while(tape[index]) {
-                tape[index]--;
-                index += 9;
-                tape[index]++;
-                index -= 9;
+            if (tape[index] != 0)
+            {
+                tape[index+9] += tape[index];
             }
+            tape[index] = 0;
             index += 9;
         }
-        index += 5;
-        tape[index]++;
-        index += 9;
-        tape[index]++;
-        index -= 15;
-        while(tape[index]) {
-            index -= 9;
-        }
+        tape[index+5]++;
+        tape[index+14]++;
+        index--;
+        index = scan_left(index, 9);
         index += 8;
-        while(tape[index]) {
-            tape[index]--;
-            index -= 8;
-            tape[index]++;
-            index += 8;
+        if (tape[index] != 0)
+        {
+            tape[index-8] += tape[index];
         }
+        tape[index] = 0;
         index -= 8;
         while(tape[index]) {
             tape[index]--;
-            index += 8;
-            tape[index]++;
-            while(tape[index]) {
-                tape[index]--;
-            }
-            index++;
-            while(tape[index]) {
-                index += 9;
-            }
+            tape[index+8]++;
+            tape[index+8] = 0;
+            index += 9;
+            index = scan_right(index, 9);
             index -= 9;
             while(tape[index]) {
                 index += 8;
-                while(tape[index]) {
-                    tape[index]--;
-                    index -= 7;
-                    tape[index]++;
-                    index += 7;
+                if (tape[index] != 0)
+                {
+                    tape[index-7] += tape[index];
                 }
+                tape[index] = 0;
                 index -= 7;
                 while(tape[index]) {
                     tape[index]--;
-                    index += 7;
-                    tape[index]++;
-                    index -= 8;
-                    while(tape[index]) {
-                        index -= 9;
-                    }
-                    index += 8;
-                    while(tape[index]) {
-                        tape[index]--;
-                    }
-                    tape[index]++;
-                    index += 2;
+                    tape[index+7]++;
+                    index--;
+                    index = scan_left(index, 9);
+                    tape[index+8] = 1;
+                    index += 10;
                 }
                 index -= 10;
             }
         }
         index += 8;
-        while(tape[index]) {
-            tape[index]--;
-            index -= 8;
-            tape[index]++;
-            index += 8;
+        if (tape[index] != 0)
+        {
+            tape[index-8] += tape[index];
         }
+        tape[index] = 0;
         index -= 8;
         while(tape[index]) {
             tape[index]--;
-            index += 8;
-            tape[index]++;
-            index++;
+            tape[index+8]++;
+            index += 9;
             while(tape[index]) {
-                index++;
-                tape[index]++;
-                index += 5;
-                while(tape[index]) {
-                    tape[index]--;
-                    index -= 5;
-                    tape[index]--;
-                    index += 5;
+                tape[index+1]++;
+                index += 6;
+                if (tape[index] != 0)
+                {
+                    tape[index-5] -= tape[index];
                 }
+                tape[index] = 0;
                 index -= 5;
-                while(tape[index]) {
-                    tape[index]--;
-                    index += 5;
-                    tape[index]++;
-                    index -= 5;
+                if (tape[index] != 0)
+                {
+                    tape[index+5] += tape[index];
                 }
+                tape[index] = 0;
                 index += 8;
             }
-            index--;
-            tape[index]++;
-            index -= 8;
+            tape[index-1]++;
+            index -= 9;
             while(tape[index]) {
                 index += 6;
-                while(tape[index]) {
-                    tape[index]--;
-                    index += 2;
-                    tape[index]++;
-                    index -= 2;
+                if (tape[index] != 0)
+                {
+                    tape[index+2] += tape[index];
                 }
+                tape[index] = 0;
                 index -= 15;
             }
             index += 9;
-            while(tape[index]) {
-                index += 9;
-            }
+            index = scan_right(index, 9);
             index -= 9;
             while(tape[index]) {
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index--;
+                tape[index+1] = 0;
                 tape[index]--;
                 index += 8;
                 while(tape[index]) {
                     tape[index]--;
-                    index -= 8;
-                    tape[index]++;
-                    index++;
-                    while(tape[index]) {
-                        index--;
-                        tape[index]--;
-                        index++;
-                        tape[index]--;
-                        index -= 2;
-                        tape[index]++;
-                        index += 2;
+                    tape[index-8]++;
+                    index -= 7;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-1] -= tape[index];
+                        tape[index-2] += tape[index];
                     }
+                    tape[index] = 0;
                     index--;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index++;
-                        tape[index]++;
-                        index--;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+1] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 8;
                 }
                 index -= 7;
-                while(tape[index]) {
-                    tape[index]--;
-                    index += 7;
-                    tape[index]++;
-                    index -= 7;
+                if (tape[index] != 0)
+                {
+                    tape[index+7] += tape[index];
                 }
-                index--;
-                tape[index]++;
-                index -= 9;
-            }
-            index += 8;
-            tape[index]--;
-            index -= 5;
-            while(tape[index]) {
-                tape[index]--;
+                tape[index] = 0;
+                tape[index-1]++;
+                index -= 10;
             }
-            tape[index]++;
-            index -= 3;
+            tape[index+8]--;
+            tape[index+3] = 1;
         }
         tape[index]++;
         index += 8;
-        while(tape[index]) {
-            tape[index]--;
-            index -= 8;
-            tape[index]--;
-            index += 8;
+        if (tape[index] != 0)
+        {
+            tape[index-8] -= tape[index];
         }
-        tape[index]++;
+        tape[index] = 1;
         index -= 8;
         while(tape[index]) {
             tape[index]--;
-            index += 8;
-            tape[index]--;
-            index++;
+            tape[index+8]--;
+            index += 9;
             while(tape[index]) {
                 index += 6;
-                while(tape[index]) {
-                    tape[index]--;
-                    index += 2;
-                    tape[index]++;
-                    index -= 2;
+                if (tape[index] != 0)
+                {
+                    tape[index+2] += tape[index];
                 }
+                tape[index] = 0;
                 index += 3;
             }
             index -= 9;
             while(tape[index]) {
-                index++;
-                while(tape[index]) {
-                    tape[index]--;
-                }
-                index--;
+                tape[index+1] = 0;
                 tape[index]--;
                 index += 8;
                 while(tape[index]) {
                     tape[index]--;
-                    index -= 8;
-                    tape[index]++;
-                    index++;
-                    while(tape[index]) {
-                        index--;
-                        tape[index]--;
-                        index++;
-                        tape[index]--;
-                        index -= 2;
-                        tape[index]++;
-                        index += 2;
+                    tape[index-8]++;
+                    index -= 7;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-1] -= tape[index];
+                        tape[index-2] += tape[index];
                     }
+                    tape[index] = 0;
                     index--;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index++;
-                        tape[index]++;
-                        index--;
+                    if (tape[index] != 0)
+                    {
+                        tape[index+1] += tape[index];
                     }
+                    tape[index] = 0;
                     index += 8;
                 }
                 index -= 7;
-                while(tape[index]) {
-                    tape[index]--;
-                    index += 7;
-                    tape[index]++;
-                    index -= 7;
+                if (tape[index] != 0)
+                {
+                    tape[index+7] += tape[index];
                 }
-                index--;
-                tape[index]++;
-                index -= 9;
+                tape[index] = 0;
+                tape[index-1]++;
+                index -= 10;
             }
+            tape[index+1] += 5;
             index++;
-            tape[index] += 5;
             while(tape[index]) {
                 tape[index]--;
-                while(tape[index]) {
-                    tape[index]--;
-                    index += 9;
-                    tape[index]++;
-                    index -= 9;
+                if (tape[index] != 0)
+                {
+                    tape[index+9] += tape[index];
                 }
+                tape[index] = 0;
                 index += 9;
             }
-            index += 5;
-            tape[index]++;
-            index += 27;
-            tape[index]++;
-            index -= 6;
-            while(tape[index]) {
-                index -= 9;
-            }
+            tape[index+5]++;
+            tape[index+32]++;
+            index += 26;
+            index = scan_left(index, 9);
             index += 9;
             while(tape[index]) {
                 index += 6;
-                while(tape[index]) {
-                    tape[index]--;
-                    index -= 6;
-                    tape[index]--;
-                    index += 6;
+                if (tape[index] != 0)
+                {
+                    tape[index-6] -= tape[index];
                 }
-                tape[index]++;
+                tape[index] = 1;
                 index -= 6;
                 while(tape[index]) {
                     tape[index]--;
-                    index += 6;
-                    tape[index]--;
-                    index += 2;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 8;
-                        tape[index]++;
-                        index += 8;
+                    tape[index+6]--;
+                    index += 8;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-8] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 8;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 8;
-                        tape[index]++;
-                        index -= 17;
-                        while(tape[index]) {
-                            index -= 9;
-                        }
-                        index += 4;
-                        while(tape[index]) {
-                            tape[index]--;
-                        }
-                        tape[index]++;
-                        index += 5;
-                        while(tape[index]) {
-                            index += 9;
-                        }
-                        index++;
-                        tape[index]++;
-                        index--;
+                        tape[index+8]++;
+                        index -= 9;
+                        index = scan_left(index, 9);
+                        tape[index+4] = 1;
+                        index += 9;
+                        index = scan_right(index, 9);
+                        tape[index+1]++;
                     }
                 }
                 tape[index]++;
                 index += 8;
-                while(tape[index]) {
-                    tape[index]--;
-                    index -= 8;
-                    tape[index]--;
-                    index += 8;
+                if (tape[index] != 0)
+                {
+                    tape[index-8] -= tape[index];
                 }
-                tape[index]++;
+                tape[index] = 1;
                 index -= 8;
                 while(tape[index]) {
                     tape[index]--;
-                    index += 8;
-                    tape[index]--;
-                    index -= 2;
-                    while(tape[index]) {
-                        tape[index]--;
-                        index -= 6;
-                        tape[index]++;
-                        index += 6;
+                    tape[index+8]--;
+                    index += 6;
+                    if (tape[index] != 0)
+                    {
+                        tape[index-6] += tape[index];
                     }
+                    tape[index] = 0;
                     index -= 6;
                     while(tape[index]) {
                         tape[index]--;
-                        index += 6;
-                        tape[index]++;
-                        index -= 15;
-                        while(tape[index]) {
-                            index -= 9;
-                        }
-                        index += 3;
-                        while(tape[index]) {
-                            tape[index]--;
-                        }
-                        tape[index]++;
-                        index += 6;
-                        while(tape[index]) {
-                            index += 9;
-                        }
-                        index++;
-                        while(tape[index]) {
-                            tape[index]--;
-                        }
-                        tape[index]++;
-                        index--;
+                        tape[index+6]++;
+                        index -= 9;
+                        index = scan_left(index, 9);
+                        tape[index+3] = 1;
+                        index += 9;
+                        index = scan_right(index, 9);
+                        tape[index+1] = 1;
                     }
                 }
                 tape[index]++;
@@ -4086,44 +3116,33 @@ int main(void)
                 while(tape[index]) {
                     tape[index]--;
                     index--;
-                    while(tape[index]) {
-                        index += 9;
-                    }
+                    index = scan_right(index, 9);
                     index -= 8;
                 }
                 index += 8;
             }
             index -= 9;
-            while(tape[index]) {
-                index -= 9;
-            }
-            index += 4;
-            while(tape[index]) {
-                tape[index]--;
-            }
-            index -= 3;
-            tape[index] += 5;
+            index = scan_left(index, 9);
+            tape[index+4] = 0;
+            tape[index+1] += 5;
+            index++;
             while(tape[index]) {
                 tape[index]--;
-                while(tape[index]) {
-                    tape[index]--;
-                    index += 9;
-                    tape[index]++;
-                    index -= 9;
+                if (tape[index] != 0)
+                {
+                    tape[index+9] += tape[index];
                 }
+                tape[index] = 0;
                 index += 9;
             }
-            index += 5;
-            tape[index]--;
-            index += 27;
-            tape[index]--;
-            index -= 6;
-            while(tape[index]) {
-                index -= 9;
-            }
+            tape[index+5]--;
+            tape[index+32]--;
+            index += 26;
+            index = scan_left(index, 9);
         }
         index += 3;
     }
     // END
+    out_flush();
     return 0;
 }
\ No newline at end of file